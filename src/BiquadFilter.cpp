@@ -6,22 +6,26 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-BiquadFilter::BiquadFilter() = default;
+template <typename SampleType>
+BiquadFilter<SampleType>::BiquadFilter() = default;
 
-void BiquadFilter::prepare(double newSampleRate)
+template <typename SampleType>
+void BiquadFilter<SampleType>::prepare(double newSampleRate)
 {
     sampleRate = newSampleRate;
     needsRecalc = true;
     reset();
 }
 
-void BiquadFilter::reset()
+template <typename SampleType>
+void BiquadFilter<SampleType>::reset()
 {
-    z1 = 0.0f;
-    z2 = 0.0f;
+    z1 = 0;
+    z2 = 0;
 }
 
-void BiquadFilter::setType(Type newType)
+template <typename SampleType>
+void BiquadFilter<SampleType>::setType(Type newType)
 {
     if (filterType != newType)
     {
@@ -30,7 +34,8 @@ void BiquadFilter::setType(Type newType)
     }
 }
 
-void BiquadFilter::setFrequency(float freqHz)
+template <typename SampleType>
+void BiquadFilter<SampleType>::setFrequency(float freqHz)
 {
     freqHz = std::clamp(freqHz, 20.0f, 20000.0f);
     if (frequency != freqHz)
@@ -40,7 +45,8 @@ void BiquadFilter::setFrequency(float freqHz)
     }
 }
 
-void BiquadFilter::setQ(float newQ)
+template <typename SampleType>
+void BiquadFilter<SampleType>::setQ(float newQ)
 {
     newQ = std::clamp(newQ, 0.1f, 10.0f);
     if (q != newQ)
@@ -50,7 +56,8 @@ void BiquadFilter::setQ(float newQ)
     }
 }
 
-float BiquadFilter::process(float inputSample)
+template <typename SampleType>
+SampleType BiquadFilter<SampleType>::process(SampleType inputSample)
 {
     if (needsRecalc)
     {
@@ -59,60 +66,76 @@ float BiquadFilter::process(float inputSample)
     }
 
     // Direct Form II Transposed
-    float output = b0 * inputSample + z1;
+    SampleType output = b0 * inputSample + z1;
     z1 = b1 * inputSample - a1 * output + z2;
     z2 = b2 * inputSample - a2 * output;
 
     return output;
 }
 
-void BiquadFilter::recalculateCoefficients()
+template <typename SampleType>
+void BiquadFilter<SampleType>::recalculateCoefficients()
 {
-    float w0 = static_cast<float>(2.0 * M_PI * frequency / sampleRate);
-    float cosW0 = std::cos(w0);
-    float sinW0 = std::sin(w0);
-    float alpha = sinW0 / (2.0f * q);
+    const auto c = calculateCoefficients(filterType, frequency, q, sampleRate);
+    b0 = c.b0;
+    b1 = c.b1;
+    b2 = c.b2;
+    a1 = c.a1;
+    a2 = c.a2;
+}
+
+template <typename SampleType>
+typename BiquadFilter<SampleType>::Coefficients BiquadFilter<SampleType>::calculateCoefficients(Type type, float freqHz, float filterQ, double newSampleRate)
+{
+    const SampleType one = 1, two = 2;
+    SampleType w0 = static_cast<SampleType>(2.0 * M_PI * freqHz / newSampleRate);
+    SampleType cosW0 = std::cos(w0);
+    SampleType sinW0 = std::sin(w0);
+    SampleType alpha = sinW0 / (two * static_cast<SampleType>(filterQ));
 
-    float a0;
+    Coefficients c;
+    SampleType a0 = one + alpha;
 
-    switch (filterType)
+    switch (type)
     {
         case Type::LowPass:
         {
-            b0 = (1.0f - cosW0) / 2.0f;
-            b1 = 1.0f - cosW0;
-            b2 = (1.0f - cosW0) / 2.0f;
-            a0 = 1.0f + alpha;
-            a1 = -2.0f * cosW0;
-            a2 = 1.0f - alpha;
+            c.b0 = (one - cosW0) / two;
+            c.b1 = one - cosW0;
+            c.b2 = (one - cosW0) / two;
+            c.a1 = -two * cosW0;
+            c.a2 = one - alpha;
             break;
         }
         case Type::HighPass:
         {
-            b0 = (1.0f + cosW0) / 2.0f;
-            b1 = -(1.0f + cosW0);
-            b2 = (1.0f + cosW0) / 2.0f;
-            a0 = 1.0f + alpha;
-            a1 = -2.0f * cosW0;
-            a2 = 1.0f - alpha;
+            c.b0 = (one + cosW0) / two;
+            c.b1 = -(one + cosW0);
+            c.b2 = (one + cosW0) / two;
+            c.a1 = -two * cosW0;
+            c.a2 = one - alpha;
             break;
         }
         case Type::BandPass:
         {
-            b0 = alpha;
-            b1 = 0.0f;
-            b2 = -alpha;
-            a0 = 1.0f + alpha;
-            a1 = -2.0f * cosW0;
-            a2 = 1.0f - alpha;
+            c.b0 = alpha;
+            c.b1 = 0;
+            c.b2 = -alpha;
+            c.a1 = -two * cosW0;
+            c.a2 = one - alpha;
             break;
         }
     }
 
     // Normalize by a0
-    b0 /= a0;
-    b1 /= a0;
-    b2 /= a0;
-    a1 /= a0;
-    a2 /= a0;
+    c.b0 /= a0;
+    c.b1 /= a0;
+    c.b2 /= a0;
+    c.a1 /= a0;
+    c.a2 /= a0;
+
+    return c;
 }
+
+template class BiquadFilter<float>;
+template class BiquadFilter<double>;
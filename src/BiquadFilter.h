@@ -2,7 +2,9 @@
 
 /**
  * Second-order biquad IIR filter supporting LP, HP, and BP modes.
+ * Instantiated for float and double in BiquadFilter.cpp.
  */
+template <typename SampleType>
 class BiquadFilter
 {
 public:
@@ -13,6 +15,15 @@ public:
         BandPass = 2
     };
 
+    // Normalised coefficients (a0 = 1)
+    struct Coefficients
+    {
+        SampleType b0 = 1, b1 = 0, b2 = 0;
+        SampleType a1 = 0, a2 = 0;
+    };
+
+    static Coefficients calculateCoefficients(Type type, float freqHz, float filterQ, double newSampleRate);
+
     BiquadFilter();
 
     void prepare(double sampleRate);
@@ -25,7 +36,7 @@ public:
     Type getType() const { return filterType; }
     float getFrequency() const { return frequency; }
 
-    float process(float inputSample);
+    SampleType process(SampleType inputSample);
 
 private:
     void recalculateCoefficients();
@@ -36,11 +47,11 @@ private:
     double sampleRate = 44100.0;
 
     // Biquad coefficients
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
-    float a1 = 0.0f, a2 = 0.0f;
+    SampleType b0 = 1, b1 = 0, b2 = 0;
+    SampleType a1 = 0, a2 = 0;
 
     // State variables (Direct Form II Transposed)
-    float z1 = 0.0f, z2 = 0.0f;
+    SampleType z1 = 0, z2 = 0;
 
     bool needsRecalc = true;
 };
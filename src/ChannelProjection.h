@@ -0,0 +1,138 @@
+// ChannelProjection.h
+// FIELD — Projection Engine
+// Where each tap of the early field lands on a surround or immersive speaker layout
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+
+namespace ChannelProjection {
+
+// Largest supported layout (7.1.4)
+inline constexpr int maxChannels = 12;
+
+// Per-channel gains of one tap; channels past the layout's size stay zero
+using ChannelGains = std::array<double, maxChannels>;
+
+// The stereo pan range (-100..+100) maps onto +/- this azimuth, so the widest
+// taps wrap past the front speakers towards the surrounds
+inline constexpr double panSpreadDegrees = 110.0;
+
+// Elevation of the field on layouts with a height layer
+inline constexpr double heightElevationDegrees = 30.0;
+
+struct Speaker {
+    double azimuth;     // Degrees, 0 = front centre, positive to the right
+    bool height;        // Upper layer
+};
+
+// Nominal position of a channel, or nothing for channels the field does not
+// feed (LFE and anything unrecognised)
+inline std::optional<Speaker> getSpeaker(juce::AudioChannelSet::ChannelType type) {
+    using Set = juce::AudioChannelSet;
+
+    switch (type) {
+        case Set::left:              return Speaker { -30.0, false };
+        case Set::right:             return Speaker { 30.0, false };
+        case Set::centre:            return Speaker { 0.0, false };
+        case Set::leftSurround:      return Speaker { -110.0, false };
+        case Set::rightSurround:     return Speaker { 110.0, false };
+        case Set::leftSurroundSide:  return Speaker { -90.0, false };
+        case Set::rightSurroundSide: return Speaker { 90.0, false };
+        case Set::leftSurroundRear:  return Speaker { -150.0, false };
+        case Set::rightSurroundRear: return Speaker { 150.0, false };
+        case Set::topFrontLeft:      return Speaker { -45.0, true };
+        case Set::topFrontRight:     return Speaker { 45.0, true };
+        case Set::topRearLeft:       return Speaker { -135.0, true };
+        case Set::topRearRight:      return Speaker { 135.0, true };
+        default:                     return std::nullopt;
+    }
+}
+
+namespace detail {
+
+// One layer of speakers, sorted by azimuth
+struct Ring {
+    std::array<int, maxChannels> channels {};
+    std::array<double, maxChannels> azimuths {};
+    int size = 0;
+};
+
+inline Ring makeRing(const juce::AudioChannelSet& layout, bool height) {
+    Ring ring;
+
+    for (int channel = 0; channel < juce::jmin(layout.size(), maxChannels); ++channel) {
+        const auto speaker = getSpeaker(layout.getTypeOfChannel(channel));
+
+        if (speaker.has_value() && speaker->height == height) {
+            int i = ring.size++;
+
+            for (; i > 0 && ring.azimuths[static_cast<size_t>(i - 1)] > speaker->azimuth; --i) {
+                ring.channels[static_cast<size_t>(i)] = ring.channels[static_cast<size_t>(i - 1)];
+                ring.azimuths[static_cast<size_t>(i)] = ring.azimuths[static_cast<size_t>(i - 1)];
+            }
+
+            ring.channels[static_cast<size_t>(i)] = channel;
+            ring.azimuths[static_cast<size_t>(i)] = speaker->azimuth;
+        }
+    }
+
+    return ring;
+}
+
+// Constant-power pan between the two ring neighbours either side of azimuth
+inline void panPairwise(const Ring& ring, double azimuth, double level, ChannelGains& gains) {
+    if (ring.size == 0) {
+        return;
+    }
+
+    if (ring.size == 1) {
+        gains[static_cast<size_t>(ring.channels[0])] += level;
+        return;
+    }
+
+    for (int i = 0; i < ring.size; ++i) {
+        const int next = (i + 1) % ring.size;
+        const double from = ring.azimuths[static_cast<size_t>(i)];
+        const double span = std::fmod(ring.azimuths[static_cast<size_t>(next)] - from + 360.0, 360.0);
+        const double offset = std::fmod(azimuth - from + 360.0, 360.0);
+
+        if (offset <= span) {
+            const double angle = (span > 0.0 ? offset / span : 0.0) * juce::MathConstants<double>::halfPi;
+            gains[static_cast<size_t>(ring.channels[static_cast<size_t>(i)])] += level * std::cos(angle);
+            gains[static_cast<size_t>(ring.channels[static_cast<size_t>(next)])] += level * std::sin(angle);
+            return;
+        }
+    }
+}
+
+} // namespace detail
+
+// Constant-power gains of a tap at the given stereo pan (-100..+100) on every
+// channel of layout. On layouts with a height layer the tap is split between
+// the ear-level and height rings at heightElevationDegrees.
+inline ChannelGains getTapGains(double pan, const juce::AudioChannelSet& layout) {
+    ChannelGains gains {};
+
+    const double azimuth = std::clamp(pan, -100.0, 100.0) / 100.0 * panSpreadDegrees;
+    const auto earRing = detail::makeRing(layout, false);
+    const auto heightRing = detail::makeRing(layout, true);
+    const double elevation = heightRing.size > 0 ? juce::degreesToRadians(heightElevationDegrees) : 0.0;
+
+    detail::panPairwise(earRing, azimuth, std::cos(elevation), gains);
+    detail::panPairwise(heightRing, azimuth, std::sin(elevation), gains);
+
+    return gains;
+}
+
+// Whether a channel is summed into the field's mono input
+inline bool feedsField(const juce::AudioChannelSet& layout, int channel) {
+    return getSpeaker(layout.getTypeOfChannel(channel)).has_value();
+}
+
+} // namespace ChannelProjection
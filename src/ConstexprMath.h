@@ -0,0 +1,72 @@
+// ConstexprMath.h
+// FIELD — Projection Engine
+// Compile-time sin, cos, exp and log for the preset tables
+
+#pragma once
+
+// constexpr maths, accurate to double precision over the ranges the presets
+// use (std's are not constexpr before C++26). ModePresets derives its denser
+// fields with these and PresetCoefficients its coefficient tables, so both
+// share one implementation.
+namespace ConstexprMath {
+
+inline constexpr double pi = 3.14159265358979323846;
+inline constexpr double ln2 = 0.69314718055994530942;
+inline constexpr double ln10 = 2.30258509299404568402;
+
+constexpr double sin(double x) {
+    // Reduce to [-pi, pi], then to [-pi/2, pi/2] where the series converges fast
+    x -= 2.0 * pi * static_cast<double>(static_cast<long long>(x / (2.0 * pi)));
+    if (x > pi) x -= 2.0 * pi;
+    if (x < -pi) x += 2.0 * pi;
+    if (x > pi / 2.0) x = pi - x;
+    if (x < -pi / 2.0) x = -pi - x;
+
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(double x) {
+    return sin(x + pi / 2.0);
+}
+
+constexpr double exp(double x) {
+    // x = k*ln2 + r with |r| <= ln2/2, exp(x) = 2^k * exp(r)
+    const auto k = static_cast<long long>(x / ln2 + (x < 0.0 ? -0.5 : 0.5));
+    const double r = x - static_cast<double>(k) * ln2;
+
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= r / static_cast<double>(n);
+        sum += term;
+    }
+
+    for (long long i = 0; i < k; ++i) sum *= 2.0;
+    for (long long i = 0; i > k; --i) sum *= 0.5;
+    return sum;
+}
+
+// ln(x) for x > 0, as 2 * atanh((x - 1) / (x + 1))
+constexpr double log(double x) {
+    const double u = (x - 1.0) / (x + 1.0);
+    double term = u;
+    double sum = 0.0;
+    for (int n = 1; n < 200; n += 2) {
+        sum += term / static_cast<double>(n);
+        term *= u * u;
+    }
+    return 2.0 * sum;
+}
+
+// Same as juce::Decibels::decibelsToGain, including its -100 dB floor
+constexpr double decibelsToGain(double dB) {
+    return dB > -100.0 ? exp(dB * ln10 / 20.0) : 0.0;
+}
+
+} // namespace ConstexprMath
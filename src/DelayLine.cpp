@@ -2,50 +2,162 @@
 #include <algorithm>
 #include <cmath>
 
-DelayLine::DelayLine() = default;
+namespace
+{
+    // Minimum room left for a processBlock() chunk once the delay history is reserved
+    constexpr size_t minBlockHeadroom = 64;
+
+    size_t nextPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+}
 
-void DelayLine::prepare(double newSampleRate, int maxDelayMs)
+template <typename SampleType>
+DelayLine<SampleType>::DelayLine() = default;
+
+template <typename SampleType>
+void DelayLine<SampleType>::prepare(double newSampleRate, float newMaxDelayMs, int maxBlockSize, DspArena& arena)
 {
     sampleRate = newSampleRate;
-    // Buffer size = max delay in samples + 1 for interpolation
-    bufferSize = static_cast<size_t>(std::ceil(sampleRate * maxDelayMs / 1000.0)) + 2;
-    buffer.resize(bufferSize, 0.0f);
+    maxDelayMs = newMaxDelayMs;
+
+    // Max delay in samples + 2 for interpolation, rounded up to a power of two
+    const auto maxDelaySamples = static_cast<size_t>(std::ceil(sampleRate * maxDelayMs / 1000.0)) + 2;
+    const auto headroom = std::max(minBlockHeadroom, static_cast<size_t>(std::max(maxBlockSize, 0)));
+    bufferSize = nextPowerOfTwo(maxDelaySamples + headroom);
+    bufferMask = bufferSize - 1;
+    maxChunkSize = static_cast<int>(bufferSize - maxDelaySamples);
+
+    buffer = arena.allocate<SampleType>(bufferSize);
     reset();
+    setDelayMs(currentDelayMs);
 }
 
-void DelayLine::reset()
+template <typename SampleType>
+void DelayLine<SampleType>::reset()
 {
-    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    std::fill(buffer.begin(), buffer.end(), SampleType(0));
     writeIndex = 0;
 }
 
-void DelayLine::setDelayMs(float delayMs)
+template <typename SampleType>
+void DelayLine<SampleType>::setDelayMs(float delayMs)
 {
-    currentDelayMs = std::clamp(delayMs, 0.0f, 100.0f);
-    delaySamples = static_cast<float>(currentDelayMs * sampleRate / 1000.0);
+    currentDelayMs = std::clamp(delayMs, 0.0f, maxDelayMs);
+    delay = makeTap(currentDelayMs);
 }
 
-float DelayLine::process(float inputSample)
+template <typename SampleType>
+void DelayLine<SampleType>::setDelaySamples(int delaySamples)
 {
-    // Write input to buffer
-    buffer[writeIndex] = inputSample;
+    const auto maxDelaySamples = static_cast<int>(maxDelayMs * sampleRate / 1000.0);
+    delay.wholeSamples = static_cast<size_t>(std::clamp(delaySamples, 0, maxDelaySamples));
+    delay.fraction = 0;
+    currentDelayMs = static_cast<float>(static_cast<double>(delay.wholeSamples) * 1000.0 / sampleRate);
+}
 
-    // Calculate read position with linear interpolation
-    float readPos = static_cast<float>(writeIndex) - delaySamples;
-    if (readPos < 0.0f)
-        readPos += static_cast<float>(bufferSize);
+template <typename SampleType>
+typename DelayLine<SampleType>::Tap DelayLine<SampleType>::makeTap(float delayMs) const
+{
+    const auto delaySamples = std::clamp(delayMs, 0.0f, maxDelayMs) * sampleRate / 1000.0;
 
-    // Integer and fractional parts for interpolation
-    auto readIndex0 = static_cast<size_t>(readPos);
-    float frac = readPos - static_cast<float>(readIndex0);
-    size_t readIndex1 = (readIndex0 + 1) % bufferSize;
-    readIndex0 = readIndex0 % bufferSize;
+    Tap tap;
+    tap.wholeSamples = static_cast<size_t>(delaySamples);
+    tap.fraction = static_cast<SampleType>(delaySamples - static_cast<double>(tap.wholeSamples));
+    return tap;
+}
 
-    // Linear interpolation
-    float output = buffer[readIndex0] + frac * (buffer[readIndex1] - buffer[readIndex0]);
+template <typename SampleType>
+SampleType DelayLine<SampleType>::process(SampleType inputSample)
+{
+    // Write input to buffer
+    buffer[writeIndex] = inputSample;
+
+    // Linear interpolation between the sample wholeSamples behind the write
+    // position and the one before it
+    const SampleType newer = buffer[(writeIndex - delay.wholeSamples) & bufferMask];
+    const SampleType older = buffer[(writeIndex - delay.wholeSamples - 1) & bufferMask];
+    SampleType output = newer + delay.fraction * (older - newer);
 
     // Advance write pointer
-    writeIndex = (writeIndex + 1) % bufferSize;
+    writeIndex = (writeIndex + 1) & bufferMask;
 
     return output;
 }
+
+template <typename SampleType>
+void DelayLine<SampleType>::processBlock(const SampleType* input, SampleType* output, int numSamples)
+{
+    while (numSamples > 0)
+    {
+        const int chunk = std::min(numSamples, maxChunkSize);
+        const size_t startIndex = writeIndex;
+
+        // The whole chunk is written before any of it is read, so delays shorter
+        // than the chunk still see the same history as process()
+        writeBlock(input, chunk);
+        readBlock(delay, startIndex, output, chunk, 1);
+
+        input += chunk;
+        output += chunk;
+        numSamples -= chunk;
+    }
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::writeBlock(const SampleType* input, int numSamples)
+{
+    const auto firstSpan = std::min(static_cast<size_t>(numSamples), bufferSize - writeIndex);
+
+    std::copy(input, input + firstSpan, buffer.data() + writeIndex);
+    std::copy(input + firstSpan, input + numSamples, buffer.data());
+
+    writeIndex = (writeIndex + static_cast<size_t>(numSamples)) & bufferMask;
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::readBlock(const Tap& tap, SampleType* output, int numSamples, int outputStride) const
+{
+    readBlock(tap, (writeIndex - static_cast<size_t>(numSamples)) & bufferMask, output, numSamples, outputStride);
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::readBlock(const Tap& tap, size_t startIndex, SampleType* output, int numSamples, int outputStride) const
+{
+    const SampleType frac = tap.fraction;
+    size_t readIndex = (startIndex - tap.wholeSamples) & bufferMask;
+    SampleType older = buffer[(readIndex - 1) & bufferMask];
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        const auto span = static_cast<int>(std::min(static_cast<size_t>(numSamples - done), bufferSize - readIndex));
+        const SampleType* src = buffer.data() + readIndex;
+        SampleType* dest = output + done * outputStride;
+
+        // First sample pairs with the last one of the previous span
+        dest[0] = src[0] + frac * (older - src[0]);
+
+        if (outputStride == 1)
+        {
+            for (int i = 1; i < span; ++i)
+                dest[i] = src[i] + frac * (src[i - 1] - src[i]);
+        }
+        else
+        {
+            for (int i = 1; i < span; ++i)
+                dest[i * outputStride] = src[i] + frac * (src[i - 1] - src[i]);
+        }
+
+        older = src[span - 1];
+        done += span;
+        readIndex = (readIndex + static_cast<size_t>(span)) & bufferMask;
+    }
+}
+
+template class DelayLine<float>;
+template class DelayLine<double>;
@@ -1,29 +1,65 @@
 #pragma once
-#include <vector>
+#include "DspArena.h"
 #include <cstddef>
+#include <span>
 
 /**
  * Circular buffer delay line with linear interpolation.
- * Max delay: 100ms at any sample rate.
+ * Max delay: 100ms at any sample rate (configurable in prepare()).
+ *
+ * The buffer is carved from the owner's DspArena, so every delay line of an
+ * engine shares one pre-faulted block.
+ *
+ * The buffer length is rounded up to a power of two so that wraparound is a
+ * bitmask instead of a modulo.
+ *
+ * Instantiated for float and double in DelayLine.cpp.
  */
+template <typename SampleType>
 class DelayLine
 {
 public:
     DelayLine();
 
-    void prepare(double sampleRate, int maxDelayMs = 100);
+    // maxBlockSize reserves room so writeBlock() can take blocks of that size
+    void prepare(double sampleRate, float maxDelayMs, int maxBlockSize, DspArena& arena);
     void reset();
 
     void setDelayMs(float delayMs);
+    void setDelaySamples(int delaySamples);     // Whole-sample delay, no interpolation
     float getDelayMs() const { return currentDelayMs; }
 
-    float process(float inputSample);
+    SampleType process(SampleType inputSample);
+
+    // Block equivalent of process(). Each chunk is written in at most two
+    // contiguous spans and read back in at most two. input and output may alias.
+    void processBlock(const SampleType* input, SampleType* output, int numSamples);
+
+    // Multi-tap use: write a block once, then read it back at any number of
+    // delays. Each read covers the numSamples most recently written, so
+    // numSamples must not exceed getMaxBlockSize().
+    struct Tap
+    {
+        size_t wholeSamples = 0;
+        SampleType fraction = 0;
+    };
+
+    Tap makeTap(float delayMs) const;
+    void writeBlock(const SampleType* input, int numSamples);
+    void readBlock(const Tap& tap, SampleType* output, int numSamples, int outputStride = 1) const;
+
+    int getMaxBlockSize() const { return maxChunkSize; }
 
 private:
-    std::vector<float> buffer;
+    void readBlock(const Tap& tap, size_t startIndex, SampleType* output, int numSamples, int outputStride) const;
+
+    std::span<SampleType> buffer;
     size_t writeIndex = 0;
     size_t bufferSize = 0;
+    size_t bufferMask = 0;
+    int maxChunkSize = 0;       // Largest block that cannot overwrite unread history
+    float maxDelayMs = 100.0f;
     float currentDelayMs = 0.0f;
-    float delaySamples = 0.0f;
+    Tap delay;                  // Delay used by process()/processBlock()
     double sampleRate = 44100.0;
 };
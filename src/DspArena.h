@@ -0,0 +1,140 @@
+// DspArena.h
+// FIELD — Projection Engine
+// One contiguous, pre-faulted block for all of an engine's per-sample state
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#if JUCE_LINUX
+ #include <sys/mman.h>
+#endif
+
+/**
+ * Bump allocator for delay memory, filter state and scratch buffers.
+ *
+ * Everything is carved from one block, each buffer starting on its own
+ * cache line, so the audio thread walks one region in the order prepare()
+ * laid it out instead of heap blocks scattered by the allocator. The block
+ * is zeroed once allocated, which faults in every page before the first
+ * callback; with setLockPages() it is also locked into RAM on Linux, so it
+ * cannot be paged out between callbacks.
+ *
+ * build() runs a prepare function twice: first measuring, when allocate()
+ * only adds up sizes and returns empty spans, then against the allocated
+ * block. Prepare functions carve every buffer before touching any of them,
+ * and skip their remaining set-up while isMeasuring().
+ *
+ * The block is kept across builds while it is large enough, so preparing
+ * again at the same settings allocates nothing. Spans stay valid until the
+ * next build() or release().
+ */
+class DspArena {
+public:
+    static constexpr size_t cacheLineSize = 64;
+    static constexpr size_t pageSize = 4096;
+
+    DspArena() = default;
+    ~DspArena() { release(); }
+
+    template <typename Prepare>
+    void build(Prepare&& prepare) {
+        measuring = true;
+        used = 0;
+        prepare(*this);
+
+        reserve(used);
+
+        measuring = false;
+        used = 0;
+        prepare(*this);
+    }
+
+    // count zero-initialised Ts on a fresh cache line; empty while measuring
+    template <typename T>
+    std::span<T> allocate(size_t count) {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                      "The arena only holds plain data, never constructed or destroyed");
+        static_assert(alignof(T) <= cacheLineSize);
+
+        const size_t offset = (used + cacheLineSize - 1) & ~(cacheLineSize - 1);
+        used = offset + count * sizeof(T);
+
+        if (measuring) {
+            return {};
+        }
+
+        jassert(used <= capacity);
+        return { reinterpret_cast<T*>(block + offset), count };
+    }
+
+    bool isMeasuring() const { return measuring; }
+
+    // Lock the block into RAM (Linux only; elsewhere ignored). Takes effect
+    // at the next build().
+    void setLockPages(bool shouldLock) { lockRequested = shouldLock; }
+    bool isLocked() const { return locked; }
+
+    size_t getSize() const { return used; }
+
+    void release() {
+        unlock();
+
+        if (block != nullptr) {
+            ::operator delete(block, std::align_val_t { pageSize });
+        }
+
+        block = nullptr;
+        capacity = 0;
+        used = 0;
+    }
+
+private:
+    void reserve(size_t size) {
+        if (size > capacity) {
+            release();
+
+            capacity = (juce::jmax(size, size_t { 1 }) + pageSize - 1) & ~(pageSize - 1);
+            block = static_cast<std::byte*>(::operator new(capacity, std::align_val_t { pageSize }));
+        }
+
+        if (locked != lockRequested) {
+            lockRequested ? lock() : unlock();
+        }
+
+        // Writing every byte faults in every page, and clears the previous layout's state
+        std::memset(block, 0, capacity);
+    }
+
+    void lock() {
+       #if JUCE_LINUX
+        // Fails quietly past RLIMIT_MEMLOCK; the block then stays pageable
+        locked = mlock(block, capacity) == 0;
+       #endif
+    }
+
+    void unlock() {
+       #if JUCE_LINUX
+        if (locked) {
+            munlock(block, capacity);
+        }
+       #endif
+
+        locked = false;
+    }
+
+    std::byte* block = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+    bool measuring = false;
+    bool lockRequested = false;
+    bool locked = false;
+
+    JUCE_DECLARE_NON_COPYABLE(DspArena)
+};
@@ -0,0 +1,425 @@
+// FieldConvolver.h
+// FIELD — Projection Engine
+// The tap field as a measured impulse response, run through uniformly partitioned FFT convolution
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "DspArena.h"
+#include "TapBank.h"
+
+#include <memory>
+#include <span>
+
+// How FieldEngine renders the tap field
+enum class FieldRenderer {
+    taps = 0,           // TapBank: every tap evaluated per sample
+    convolution = 1     // FieldConvolver: the same field as an impulse response
+};
+
+/**
+ * Drop-in alternative to TapBank for a fixed field: the same process()
+ * and setMode() interface, with a cost that depends on the length of the
+ * field's response rather than on how many taps make it up.
+ *
+ * prepare() measures each mode's impulse response by running a click
+ * through a TapBank with the same tap count and layout, one response per
+ * output channel, cut off at the mode's 120 dB tail. The responses are
+ * split into partitions of B samples and convolved by uniformly
+ * partitioned overlap-save: one forward FFT of the input per partition,
+ * a multiply-add against every partition's spectrum from a frequency-domain
+ * delay line, and one inverse FFT per output channel.
+ *
+ * Overlap-save delays its output by one partition. The field's shortest
+ * tap delay covers that: B is the largest power of two no longer than the
+ * silence at the start of every response, and the responses are convolved
+ * with that silence removed, so no latency is added.
+ *
+ * Mode changes crossfade between two responses over the same input spectra,
+ * and start at the next partition boundary, at most B samples later. The
+ * FFT runs in single precision, as juce::dsp::FFT only transforms floats:
+ * the double path converts on the way in and out, so its field is accurate
+ * to float rounding rather than to double like TapBank's.
+ *
+ * Spectra, input frames and output blocks are carved from a DspArena. The
+ * responses are measured in its measuring pass, which needs them to size
+ * the partitions, and kept for the pass that fills the spectra.
+ */
+template <typename SampleType, size_t NumTaps = ModePresets::defaultNumTaps>
+class FieldConvolver {
+public:
+    static constexpr int maxPartitionSize = 1024;
+    static constexpr int numModes = TapBank<SampleType, NumTaps>::numModes;
+
+    FieldConvolver() = default;
+
+    // Standalone use: lays the convolver out in an arena of its own
+    void prepare(double sampleRate, int maxBlockSize,
+                 const juce::AudioChannelSet& layout = juce::AudioChannelSet::stereo()) {
+        ownArena.build([&](DspArena& arena) {
+            prepare(sampleRate, maxBlockSize, layout, arena);
+        });
+    }
+
+    void prepare(double sampleRate, int maxBlockSize, const juce::AudioChannelSet& layout, DspArena& arena) {
+        juce::ignoreUnused(maxBlockSize);
+
+        numOutputChannels = layout.size();
+
+        // Response length: the longest tail of any mode
+        float tailMs = 0.0f;
+
+        for (int mode = 0; mode < numModes; ++mode) {
+            tailMs = std::max(tailMs, ModePresets::getTailMs(ModePresets::getField<NumTaps>(mode)));
+        }
+
+        const int responseLength = static_cast<int>(std::ceil(tailMs * sampleRate / 1000.0));
+
+        if (arena.isMeasuring() || measuredResponses.empty()) {
+            measuredResponses = measureResponses(sampleRate, layout, responseLength);
+        }
+
+        // The partition fits inside the silence before the first tap
+        int leadingSilence = responseLength;
+
+        for (const auto& response : measuredResponses) {
+            const auto first = std::find_if(response.begin(), response.end(), [](SampleType s) { return s != SampleType(0); });
+            leadingSilence = juce::jmin(leadingSilence, static_cast<int>(first - response.begin()));
+        }
+
+        partitionSize = 1;
+
+        while (partitionSize * 2 <= juce::jmin(leadingSilence, maxPartitionSize)) {
+            partitionSize *= 2;
+        }
+
+        numBins = partitionSize + 1;
+        numPartitions = juce::jmax(1, (responseLength - 1) / partitionSize);    // Covers the response past the first partition
+
+        // Everything process() touches, in one arena
+        fftBuffer = arena.allocate<float>(static_cast<size_t>(4 * partitionSize));
+        filterSpectra = allocateSpectra(arena, numModes * numOutputChannels * numPartitions);
+        inputSpectra = allocateSpectra(arena, numPartitions);
+        accumulator = allocateSpectrum(arena);
+        inputFrame = arena.allocate<float>(static_cast<size_t>(2 * partitionSize));
+        outputBlocks = arena.allocate<float>(static_cast<size_t>(numModes * numOutputChannels * partitionSize));
+
+        const auto fadeLength = static_cast<size_t>(juce::jmax(1, juce::roundToInt(sampleRate * crossfadeTimeSeconds)));
+        fadeOutGains = arena.allocate<float>(fadeLength);
+        fadeInGains = arena.allocate<float>(fadeLength);
+
+        if (arena.isMeasuring()) {
+            return;
+        }
+
+        fft = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(2 * partitionSize)));
+
+        // Spectra of every partition of every response, the leading silence removed
+        for (int mode = 0; mode < numModes; ++mode) {
+            for (int channel = 0; channel < numOutputChannels; ++channel) {
+                const auto& response = measuredResponses[static_cast<size_t>(mode * numOutputChannels + channel)];
+
+                for (int partition = 0; partition < numPartitions; ++partition) {
+                    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+
+                    for (int i = 0; i < partitionSize; ++i) {
+                        const int index = partitionSize * (partition + 1) + i;
+
+                        if (index < responseLength) {
+                            fftBuffer[static_cast<size_t>(i)] = static_cast<float>(response[static_cast<size_t>(index)]);
+                        }
+                    }
+
+                    fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+                    filterSpectrum(mode, channel, partition).deinterleave(fftBuffer.data());
+                }
+            }
+        }
+
+        measuredResponses = {};
+
+        // Equal-power crossfade, as TapBank
+        for (size_t i = 0; i < fadeLength; ++i) {
+            const auto angle = static_cast<float>(i + 1) / static_cast<float>(fadeLength) * juce::MathConstants<float>::halfPi;
+            fadeOutGains[i] = std::cos(angle);
+            fadeInGains[i] = std::sin(angle);
+        }
+
+        reset();
+    }
+
+    // Clears the input history and completes any pending mode change
+    void reset() {
+        for (auto& spectrum : inputSpectra) {
+            spectrum.clear();
+        }
+
+        std::fill(inputFrame.begin(), inputFrame.end(), 0.0f);
+        std::fill(outputBlocks.begin(), outputBlocks.end(), 0.0f);
+        newestSpectrum = 0;
+        framePosition = 0;
+
+        activeField = requestedField;
+        incomingField = -1;
+    }
+
+    // As TapBank::release()
+    void release() {
+        fftBuffer = inputFrame = outputBlocks = fadeOutGains = fadeInGains = {};
+        filterSpectra = inputSpectra = {};
+        accumulator = {};
+    }
+
+    // As TapBank::setMode(), but taking effect at the next partition boundary
+    void setMode(int modeIndex, bool shouldCrossfade = true) {
+        requestedField = juce::jlimit(0, numModes - 1, modeIndex);
+        crossfadeRequested = shouldCrossfade;
+    }
+
+    int getNumOutputChannels() const { return numOutputChannels; }
+    int getPartitionSize() const { return partitionSize; }
+    int getNumPartitions() const { return numPartitions; }
+
+    // Stereo layouts only
+    void process(const SampleType* monoInput, SampleType* outL, SampleType* outR, int numSamples) {
+        jassert(numOutputChannels == 2);
+        SampleType* outputs[] = { outL, outR };
+        process(monoInput, outputs, numSamples);
+    }
+
+    // One output per channel of the prepared layout
+    void process(const SampleType* monoInput, SampleType* const* outputs, int numSamples) {
+        for (int offset = 0; offset < numSamples;) {
+            const int chunkSize = juce::jmin(numSamples - offset, partitionSize - framePosition);
+
+            // Input into the second half of the frame, output from the last partition's result
+            for (int i = 0; i < chunkSize; ++i) {
+                inputFrame[static_cast<size_t>(partitionSize + framePosition + i)] = static_cast<float>(monoInput[offset + i]);
+            }
+
+            readOutput(outputs, offset, chunkSize);
+
+            offset += chunkSize;
+            framePosition += chunkSize;
+
+            if (framePosition == partitionSize) {
+                processPartition();
+                framePosition = 0;
+            }
+        }
+    }
+
+private:
+    // Bins 0..B of a real signal's spectrum, real and imaginary parts split
+    // so the multiply-add vectorises
+    struct Spectrum {
+        void clear() {
+            std::fill(re.begin(), re.end(), 0.0f);
+            std::fill(im.begin(), im.end(), 0.0f);
+        }
+
+        // From / to juce::dsp::FFT's interleaved layout
+        void deinterleave(const float* data) {
+            for (size_t k = 0; k < re.size(); ++k) {
+                re[k] = data[2 * k];
+                im[k] = data[2 * k + 1];
+            }
+        }
+
+        void interleave(float* data) const {
+            for (size_t k = 0; k < re.size(); ++k) {
+                data[2 * k] = re[k];
+                data[2 * k + 1] = im[k];
+            }
+        }
+
+        std::span<float> re, im;
+    };
+
+    // numBins bins, empty while measuring
+    Spectrum allocateSpectrum(DspArena& arena) const {
+        const auto re = arena.allocate<float>(static_cast<size_t>(numBins));
+        const auto im = arena.allocate<float>(static_cast<size_t>(numBins));
+        return { re, im };
+    }
+
+    std::span<Spectrum> allocateSpectra(DspArena& arena, int count) const {
+        const auto spectra = arena.allocate<Spectrum>(static_cast<size_t>(count));
+
+        for (int i = 0; i < count; ++i) {
+            const auto spectrum = allocateSpectrum(arena);
+
+            if (! arena.isMeasuring()) {
+                spectra[static_cast<size_t>(i)] = spectrum;
+            }
+        }
+
+        return spectra;
+    }
+
+    // Impulse responses of every mode's field, [mode * numOutputChannels + channel]
+    std::vector<std::vector<SampleType>> measureResponses(double sampleRate, const juce::AudioChannelSet& layout,
+                                                          int responseLength) const {
+        constexpr int renderBlockSize = 512;
+
+        auto bank = std::make_unique<TapBank<SampleType, NumTaps>>();
+        bank->prepare(sampleRate, renderBlockSize, layout);
+
+        std::vector<std::vector<SampleType>> responses(static_cast<size_t>(numModes * numOutputChannels),
+                                                       std::vector<SampleType>(static_cast<size_t>(responseLength), SampleType(0)));
+        std::vector<SampleType> input(static_cast<size_t>(renderBlockSize), SampleType(0));
+        juce::AudioBuffer<SampleType> output(numOutputChannels, renderBlockSize);
+
+        for (int mode = 0; mode < numModes; ++mode) {
+            bank->setMode(mode, false);
+            bank->reset();
+
+            for (int offset = 0; offset < responseLength; offset += renderBlockSize) {
+                const int blockSize = juce::jmin(renderBlockSize, responseLength - offset);
+                input[0] = offset == 0 ? SampleType(1) : SampleType(0);
+                bank->process(input.data(), output.getArrayOfWritePointers(), blockSize);
+
+                for (int channel = 0; channel < numOutputChannels; ++channel) {
+                    std::copy(output.getReadPointer(channel), output.getReadPointer(channel) + blockSize,
+                              responses[static_cast<size_t>(mode * numOutputChannels + channel)].begin() + offset);
+                }
+            }
+        }
+
+        return responses;
+    }
+
+    Spectrum& filterSpectrum(int mode, int channel, int partition) {
+        return filterSpectra[static_cast<size_t>((mode * numOutputChannels + channel) * numPartitions + partition)];
+    }
+
+    float* outputBlock(int mode, int channel) {
+        return outputBlocks.data() + (mode * numOutputChannels + channel) * partitionSize;
+    }
+
+    // A full partition of input has arrived: transform it and render the next
+    // output block of the active field (and the incoming one while fading)
+    void processPartition() {
+        // Pending mode changes start here, where both responses have output ready
+        if (incomingField < 0 && requestedField != activeField) {
+            if (crossfadeRequested) {
+                incomingField = requestedField;
+                fadePosition = 0;
+            } else {
+                activeField = requestedField;
+            }
+        }
+
+        // Overlap-save frame: the previous partition of input, then this one
+        std::copy(inputFrame.begin(), inputFrame.end(), fftBuffer.begin());
+        std::fill(fftBuffer.begin() + 2 * partitionSize, fftBuffer.end(), 0.0f);
+        fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+        newestSpectrum = (newestSpectrum + 1) % numPartitions;
+        inputSpectra[static_cast<size_t>(newestSpectrum)].deinterleave(fftBuffer.data());
+
+        std::copy(inputFrame.begin() + partitionSize, inputFrame.end(), inputFrame.begin());
+
+        renderOutput(activeField);
+
+        if (incomingField >= 0) {
+            renderOutput(incomingField);
+        }
+    }
+
+    void renderOutput(int mode) {
+        for (int channel = 0; channel < numOutputChannels; ++channel) {
+            accumulator.clear();
+
+            float* accRe = accumulator.re.data();
+            float* accIm = accumulator.im.data();
+
+            // Partition p of the response meets the input from p partitions ago
+            for (int partition = 0; partition < numPartitions; ++partition) {
+                const auto& x = inputSpectra[static_cast<size_t>((newestSpectrum - partition + numPartitions) % numPartitions)];
+                const auto& h = filterSpectrum(mode, channel, partition);
+                const float* xRe = x.re.data();
+                const float* xIm = x.im.data();
+                const float* hRe = h.re.data();
+                const float* hIm = h.im.data();
+
+                for (int k = 0; k < numBins; ++k) {
+                    accRe[k] += xRe[k] * hRe[k] - xIm[k] * hIm[k];
+                    accIm[k] += xRe[k] * hIm[k] + xIm[k] * hRe[k];
+                }
+            }
+
+            accumulator.interleave(fftBuffer.data());
+            fft->performRealOnlyInverseTransform(fftBuffer.data());
+
+            // The second half is free of circular wraparound
+            std::copy(fftBuffer.begin() + partitionSize, fftBuffer.begin() + 2 * partitionSize, outputBlock(mode, channel));
+        }
+    }
+
+    void readOutput(SampleType* const* outputs, int offset, int numSamples) {
+        int i = 0;
+
+        // Crossfade: both fields have this partition's output
+        if (incomingField >= 0) {
+            const int fadeSamples = juce::jmin(numSamples, static_cast<int>(fadeOutGains.size()) - fadePosition);
+
+            for (int channel = 0; channel < numOutputChannels; ++channel) {
+                const float* active = outputBlock(activeField, channel) + framePosition;
+                const float* incoming = outputBlock(incomingField, channel) + framePosition;
+                SampleType* out = outputs[channel] + offset;
+
+                for (int s = 0; s < fadeSamples; ++s) {
+                    out[s] = static_cast<SampleType>(active[s] * fadeOutGains[static_cast<size_t>(fadePosition + s)]
+                                                     + incoming[s] * fadeInGains[static_cast<size_t>(fadePosition + s)]);
+                }
+            }
+
+            i = fadeSamples;
+            fadePosition += fadeSamples;
+
+            if (fadePosition == static_cast<int>(fadeOutGains.size())) {
+                activeField = incomingField;
+                incomingField = -1;
+            }
+        }
+
+        for (int channel = 0; channel < numOutputChannels; ++channel) {
+            const float* active = outputBlock(activeField, channel) + framePosition;
+            SampleType* out = outputs[channel] + offset;
+
+            for (int s = i; s < numSamples; ++s) {
+                out[s] = static_cast<SampleType>(active[s]);
+            }
+        }
+    }
+
+    DspArena ownArena;                  // Used only when prepared standalone
+    std::vector<std::vector<SampleType>> measuredResponses;     // Between the measuring and allocating passes
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::span<float> fftBuffer;         // 2 * FFT size, as juce::dsp::FFT requires
+
+    int partitionSize = 1;              // B
+    int numBins = 2;                    // B + 1
+    int numPartitions = 1;
+    int numOutputChannels = 2;
+
+    std::span<Spectrum> filterSpectra;      // [mode][channel][partition]
+    std::span<Spectrum> inputSpectra;       // Frequency-domain delay line, newest at newestSpectrum
+    Spectrum accumulator;
+    int newestSpectrum = 0;
+
+    std::span<float> inputFrame;        // Previous and current partition of input
+    std::span<float> outputBlocks;      // [mode][channel], B samples each, read while the next partition fills
+    int framePosition = 0;
+
+    int activeField = 0;
+    int incomingField = -1;             // Field being faded in, -1 when not crossfading
+    int requestedField = 0;             // Latest setMode() request
+    bool crossfadeRequested = false;
+    int fadePosition = 0;
+    std::span<float> fadeOutGains, fadeInGains;
+
+    static constexpr double crossfadeTimeSeconds = 0.03;
+};
@@ -0,0 +1,462 @@
+// FieldEngine.h
+// FIELD — Projection Engine
+// The complete signal chain at one sample precision (float or double)
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ChannelProjection.h"
+#include "DspArena.h"
+#include "FieldConvolver.h"
+#include "TapBank.h"
+#include "HarmonicGenerator.h"
+#include "LookaheadLimiter.h"
+#include "OutputMeter.h"
+#include "ModePresets.h"
+
+/**
+ * Signal chain:
+ * Mono sum → Pre-Atten (-6dB) → Harmonic Gen → Soft Ceiling →
+ * 6-Tap Field → Mode Compensation → Dry/Wet
+ *
+ * The mono sum takes every channel of the layout except LFE, and the tap
+ * field projects back into all of them (see ChannelProjection); stereo is
+ * the two-channel case of the same chain.
+ *
+ * The field is rendered either tap by tap (TapBank) or as its impulse
+ * response through FFT convolution (FieldConvolver), chosen in prepare();
+ * both produce the same output within the FFT's rounding.
+ *
+ * The soft ceiling can be swapped for a true-peak lookahead limiter
+ * (setLookaheadLimiter()) on hot material; its lookahead adds to the
+ * latency, which the dry path is delayed to match.
+ *
+ * Delay lines, the renderer's buffers, the meters' staging and the block
+ * scratch are all laid out in one DspArena in prepare(), pre-faulted before
+ * the first callback. Only the oversampler keeps its own JUCE-owned memory.
+ *
+ * FieldAudioProcessor owns one engine per precision and prepares the one
+ * matching the host's processing precision. Parameters arrive already read
+ * from the APVTS; the engine holds no parameter state of its own.
+ */
+template <typename SampleType>
+class FieldEngine {
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int lanesPerRegister = static_cast<int>(Vec::size());
+    static constexpr int numMeteredChannels = 2;    // Left and right of every supported layout
+    static constexpr int subBlockSize = 32;         // ENERGY steps while ramping, independent of the host block
+
+    FieldEngine() = default;
+
+    void prepare(double sampleRate, int maxBlockSize, ExciterOversampling oversampling, bool offline,
+                 const juce::AudioChannelSet& layout = juce::AudioChannelSet::stereo(),
+                 FieldRenderer newRenderer = FieldRenderer::taps) {
+        numChannels = layout.size();
+        renderer = newRenderer;
+        blockSize = juce::jmax(1, maxBlockSize);
+
+        // Channels summed into the mono input; the averaging gain is folded
+        // into the -6 dB pre-attenuation
+        inputChannels.clear();
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            if (ChannelProjection::feedsField(layout, channel)) {
+                inputChannels.push_back(channel);
+            }
+        }
+
+        inputGain = SampleType(0.5) / static_cast<SampleType>(juce::jmax(1, static_cast<int>(inputChannels.size())));
+
+        // Harmonic stage oversampling: the realtime tier uses low-latency IIR
+        // half-bands, offline renders use linear-phase FIR half-bands
+        harmonicGen.prepare(blockSize, oversampling, offline);
+
+        // Realtime playback uses the exciter's lookup table; bounces use the exact curve
+        harmonicGen.setUseLookupTable(! offline);
+
+        dryDelays.resize(static_cast<size_t>(numChannels));
+
+        arena.build([&](DspArena& a) {
+            // Scratch buffers for block-wise processing; larger host blocks are split
+            excitedBlock = a.allocate<SampleType>(static_cast<size_t>(blockSize));
+            mixGains = a.allocate<SampleType>(static_cast<size_t>(blockSize));
+            wetChannels = a.allocate<SampleType*>(static_cast<size_t>(numChannels));
+            chunkChannels = a.allocate<SampleType*>(static_cast<size_t>(numChannels));
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const auto wetBlock = a.allocate<SampleType>(static_cast<size_t>(blockSize));
+
+                if (! a.isMeasuring()) {
+                    wetChannels[static_cast<size_t>(channel)] = wetBlock.data();
+                }
+            }
+
+            if (useLimiter) {
+                limiter.prepare(sampleRate, limiterLookaheadMs, blockSize, a);
+            }
+
+            // Delay the dry path to match the oversampling latency and the
+            // limiter's lookahead
+            latencySamples = harmonicGen.getLatencyInSamples() + (useLimiter ? limiter.getLatencySamples() : 0);
+
+            for (auto& dryDelay : dryDelays) {
+                dryDelay.prepare(sampleRate, static_cast<float>((latencySamples + 1) * 1000.0 / sampleRate), blockSize, a);
+            }
+
+            // The tap field, in whichever form renders it
+            if (renderer == FieldRenderer::convolution) {
+                convolver.prepare(sampleRate, blockSize, layout, a);
+            } else {
+                tapBank.prepare(sampleRate, blockSize, layout, a);
+            }
+
+            for (auto& meter : meters) {
+                meter.prepare(blockSize, a);
+            }
+        });
+
+        // The renderer left out of the arena keeps no spans into it (or into
+        // the block it replaced)
+        if (renderer == FieldRenderer::convolution) {
+            tapBank.release();
+        } else {
+            convolver.release();
+        }
+
+        for (auto& dryDelay : dryDelays) {
+            dryDelay.setDelaySamples(latencySamples);
+        }
+
+        // Setup smoothing for dry/wet (20ms ramp time)
+        dryWetSmoothed.reset(sampleRate, 0.02);
+        dryWetSmoothed.setCurrentAndTargetValue(SampleType(0.5));
+    }
+
+    void reset() {
+        // Only the renderer prepare() laid out has memory to clear
+        if (renderer == FieldRenderer::convolution) {
+            convolver.reset();
+        } else {
+            tapBank.reset();
+        }
+
+        harmonicGen.reset();
+
+        if (useLimiter) {
+            limiter.reset();
+        }
+
+        for (auto& dryDelay : dryDelays) {
+            dryDelay.reset();
+        }
+
+        for (auto& meter : meters) {
+            meter.reset();
+        }
+    }
+
+    // Lock the engine's DSP state into RAM (Linux only). Takes effect at the
+    // next prepare().
+    void setLockMemory(bool shouldLock) { arena.setLockPages(shouldLock); }
+    bool isMemoryLocked() const { return arena.isLocked(); }
+    size_t getStateBytes() const { return arena.getSize(); }
+
+    // Replace the soft ceiling with the true-peak lookahead limiter, looking
+    // ahead lookaheadMs (0.5-5 ms). Takes effect at the next prepare(), and
+    // adds the limiter's latency to getLatencySamples().
+    void setLookaheadLimiter(bool enabled, float lookaheadMs = LookaheadLimiter<SampleType>::defaultLookaheadMs) {
+        useLimiter = enabled;
+        limiterLookaheadMs = lookaheadMs;
+    }
+
+    int getLatencySamples() const { return latencySamples; }
+    int getNumChannels() const { return numChannels; }
+    FieldRenderer getRenderer() const { return renderer; }
+
+    void setMode(int modeIndex, bool shouldCrossfade) {
+        tapBank.setMode(modeIndex, shouldCrossfade);
+        convolver.setMode(modeIndex, shouldCrossfade);
+    }
+
+    // ENERGY (0-100) and the mode's harmonic profile. A new ENERGY ramps
+    // linearly over rampSamples (the host block, so block-rate automation
+    // becomes piecewise linear), stepping every subBlockSize samples; the
+    // profile applies from the next sub-block. Unchanged values cost nothing.
+    void setExcitation(float energy, float harmonicProfile, int rampSamples) {
+        if (! juce::exactlyEqual(energy, targetEnergy)) {
+            targetEnergy = energy;
+            energyRampRemaining = juce::jmax(subBlockSize, rampSamples);
+            energyStep = (targetEnergy - currentEnergy) / static_cast<float>(energyRampRemaining);
+        }
+
+        excitationProfile = harmonicProfile;
+    }
+
+    // Start the exciter directly on these settings, with no ramp
+    void resetExcitation(float energy, float harmonicProfile) {
+        currentEnergy = targetEnergy = energy;
+        energyRampRemaining = 0;
+        excitationProfile = harmonicProfile;
+        harmonicGen.setExcitation(energy, harmonicProfile);
+    }
+
+    // FIELD AMOUNT as 0-1
+    void setFieldAmount(float fieldAmount) {
+        dryWetSmoothed.setTargetValue(static_cast<SampleType>(fieldAmount));
+    }
+
+    // Keeps the dry/wet and ENERGY ramps in step while no audio is processed
+    void skip(int numSamples) {
+        dryWetSmoothed.skip(numSamples);
+        advanceEnergy(numSamples);
+    }
+
+    // Call from a single non-audio thread; see HarmonicGenerator::buildCurveTable()
+    void buildCurveTable(float energy, float harmonicProfile) {
+        harmonicGen.buildCurveTable(energy, harmonicProfile);
+    }
+
+    // Telemetry for the last process() call
+    const OutputMeter<SampleType>& getMeter(int channel) const { return meters[static_cast<size_t>(channel)]; }
+    float getDrive() const { return static_cast<float>(drivePeak); }
+    float getCeilingReductionDb() const {
+        return static_cast<float>(juce::Decibels::gainToDecibels(ceilingGain, SampleType(-100)));
+    }
+
+    // Process getNumChannels() channels in place, in chunks that fit the scratch buffers
+    void process(SampleType* const* channels, int numSamples, SampleType compensationGain) {
+        drivePeak = SampleType(0);
+        ceilingGain = SampleType(1);
+
+        for (auto& meter : meters) {
+            meter.beginBlock();
+        }
+
+        for (int offset = 0; offset < numSamples; offset += blockSize) {
+            const int chunkSize = juce::jmin(blockSize, numSamples - offset);
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                chunkChannels[static_cast<size_t>(channel)] = channels[channel] + offset;
+            }
+
+            processChunk(chunkChannels.data(), chunkSize, compensationGain);
+        }
+    }
+
+private:
+    void processChunk(SampleType* const* channels, int numSamples, SampleType compensationGain) {
+        SampleType* excited = excitedBlock.data();
+
+        // 1. Mono sum
+        juce::FloatVectorOperations::copy(excited, channels[inputChannels[0]], numSamples);
+
+        for (size_t i = 1; i < inputChannels.size(); ++i) {
+            juce::FloatVectorOperations::add(excited, channels[inputChannels[i]], numSamples);
+        }
+
+        // 2. Pre-attenuation (-6 dB), including the mono sum's averaging
+        juce::FloatVectorOperations::multiply(excited, inputGain, numSamples);
+
+        drivePeak = juce::jmax(drivePeak, peakOf(excited, numSamples));
+
+        // 3-4. Harmonic generator (oversampled) and the soft ceiling, as one
+        // stage. While ENERGY ramps the block is shaped in sub-blocks with
+        // fresh coefficients; settled, in one go.
+        int shaped = 0;
+
+        for (; shaped < numSamples && energyRampRemaining > 0; shaped += subBlockSize) {
+            const int subBlock = juce::jmin(subBlockSize, numSamples - shaped);
+            harmonicGen.setExcitation(advanceEnergy(subBlock), excitationProfile);
+            exciteBlock(excited + shaped, subBlock);
+        }
+
+        if (shaped < numSamples) {
+            harmonicGen.setExcitation(currentEnergy, excitationProfile);
+            exciteBlock(excited + shaped, numSamples - shaped);
+        }
+
+        // The lookahead limiter, when enabled, takes the soft ceiling's place
+        if (useLimiter) {
+            ceilingGain = juce::jmin(ceilingGain, limiter.process(excited, numSamples));
+        }
+
+        // Keep the dry signal aligned with the oversampling and limiter latency
+        if (latencySamples > 0) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                dryDelays[static_cast<size_t>(channel)].processBlock(channels[channel], channels[channel], numSamples);
+            }
+        }
+
+        // 5. 6-tap early field (all taps in parallel SIMD lanes, or convolved
+        // as one response; crossfading on mode changes), projected into every
+        // output channel
+        if (renderer == FieldRenderer::convolution) {
+            convolver.process(excited, wetChannels.data(), numSamples);
+        } else {
+            tapBank.process(excited, wetChannels.data(), numSamples);
+        }
+
+        // 6-7. Mode compensation and dry/wet mix. The front pair is metered
+        // as it is written, so the output is never read back for levels.
+        if (! dryWetSmoothed.isSmoothing()) {
+            // Settled: constant gains, compensation folded into the wet gain
+            const SampleType wetAmount = dryWetSmoothed.getTargetValue();
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                mixSettled(channels[channel], wetChannels[static_cast<size_t>(channel)], SampleType(1) - wetAmount,
+                           wetAmount * compensationGain, numSamples, meterFor(channel));
+            }
+        } else {
+            // Dry/wet ramp, shared by every channel
+            SampleType* wetAmounts = mixGains.data();
+
+            for (int sample = 0; sample < numSamples; ++sample) {
+                wetAmounts[sample] = dryWetSmoothed.getNextValue();
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                mixRamped(channels[channel], wetChannels[static_cast<size_t>(channel)], wetAmounts,
+                          compensationGain, numSamples, meterFor(channel));
+            }
+        }
+
+        for (auto& meter : meters) {
+            meter.finishChunk(numSamples);
+        }
+    }
+
+    // The exciter, with the soft ceiling in the same stage unless the
+    // limiter replaces it
+    void exciteBlock(SampleType* samples, int numSamples) {
+        if (useLimiter) {
+            harmonicGen.processBlock(samples, numSamples);
+        } else {
+            ceilingGain = juce::jmin(ceilingGain, harmonicGen.processBlockWithCeiling(samples, numSamples));
+        }
+    }
+
+    OutputMeter<SampleType>* meterFor(int channel) {
+        return channel < numMeteredChannels ? &meters[static_cast<size_t>(channel)] : nullptr;
+    }
+
+    static void mixSettled(SampleType* dry, const SampleType* wet, SampleType dryGain, SampleType wetGain,
+                           int numSamples, OutputMeter<SampleType>* meter) {
+        const auto dryGains = Vec::expand(dryGain);
+        const auto wetGains = Vec::expand(wetGain);
+        int i = 0;
+
+        for (; i + lanesPerRegister <= numSamples; i += lanesPerRegister) {
+            const Vec mixed = load(dry + i) * dryGains + load(wet + i) * wetGains;
+            store(dry + i, mixed);
+
+            if (meter != nullptr) {
+                meter->accumulate(mixed, i);
+            }
+        }
+
+        for (; i < numSamples; ++i) {
+            dry[i] = dry[i] * dryGain + wet[i] * wetGain;
+
+            if (meter != nullptr) {
+                meter->accumulate(dry[i], i);
+            }
+        }
+    }
+
+    static void mixRamped(SampleType* dry, const SampleType* wet, const SampleType* wetAmounts,
+                          SampleType compensationGain, int numSamples, OutputMeter<SampleType>* meter) {
+        const auto one = Vec::expand(SampleType(1));
+        const auto compensation = Vec::expand(compensationGain);
+        int i = 0;
+
+        for (; i + lanesPerRegister <= numSamples; i += lanesPerRegister) {
+            const Vec wetAmount = load(wetAmounts + i);
+            const Vec mixed = load(dry + i) * (one - wetAmount) + (load(wet + i) * compensation) * wetAmount;
+            store(dry + i, mixed);
+
+            if (meter != nullptr) {
+                meter->accumulate(mixed, i);
+            }
+        }
+
+        for (; i < numSamples; ++i) {
+            dry[i] = dry[i] * (SampleType(1) - wetAmounts[i]) + (wet[i] * compensationGain) * wetAmounts[i];
+
+            if (meter != nullptr) {
+                meter->accumulate(dry[i], i);
+            }
+        }
+    }
+
+    // Steps the ENERGY ramp over numSamples and returns the value at its midpoint
+    float advanceEnergy(int numSamples) {
+        const int steps = juce::jmin(numSamples, energyRampRemaining);
+
+        if (steps == 0) {
+            return currentEnergy;
+        }
+
+        const float midpoint = currentEnergy + energyStep * static_cast<float>(steps) * 0.5f;
+        energyRampRemaining -= steps;
+        currentEnergy = energyRampRemaining > 0 ? currentEnergy + energyStep * static_cast<float>(steps) : targetEnergy;
+        return midpoint;
+    }
+
+    // Host buffers carry no alignment guarantee
+    static Vec load(const SampleType* source) {
+        Vec v;
+        std::memcpy(&v, source, sizeof(Vec));
+        return v;
+    }
+
+    static void store(SampleType* destination, Vec v) {
+        std::memcpy(destination, &v, sizeof(Vec));
+    }
+
+    static SampleType peakOf(const SampleType* samples, int numSamples) {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+        return juce::jmax(-range.getStart(), range.getEnd());
+    }
+
+    //==============================================================================
+    DspArena arena;                     // Everything below that is sized in prepare()
+    TapBank<SampleType> tapBank;  // The six hand-tuned taps per mode, processed lane-parallel
+    FieldConvolver<SampleType> convolver;   // The same field as impulse responses
+    FieldRenderer renderer = FieldRenderer::taps;
+    HarmonicGenerator<SampleType> harmonicGen;    // With the soft ceiling fused in
+    LookaheadLimiter<SampleType> limiter;
+    bool useLimiter = false;
+    float limiterLookaheadMs = LookaheadLimiter<SampleType>::defaultLookaheadMs;
+
+    juce::SmoothedValue<SampleType> dryWetSmoothed;
+
+    // ENERGY ramp, in percent; the exciter's coefficients follow it per sub-block
+    float currentEnergy = 0.0f;
+    float targetEnergy = 0.0f;
+    float energyStep = 0.0f;
+    int energyRampRemaining = 0;
+    float excitationProfile = 0.5f;
+
+    // Dry path delay matching the oversampling and limiter latency, one per channel
+    std::vector<DelayLine<SampleType>> dryDelays;
+    int latencySamples = 0;
+
+    // Telemetry, reset by every process() call
+    std::array<OutputMeter<SampleType>, numMeteredChannels> meters;
+    SampleType drivePeak = SampleType(0);
+    SampleType ceilingGain = SampleType(1);
+
+    // Channel layout (set in prepare)
+    int numChannels = 2;
+    std::vector<int> inputChannels;     // Summed into the mono input (all but LFE)
+    SampleType inputGain = SampleType(0.25);
+
+    // Scratch buffers for block-wise processing (sized in prepare)
+    int blockSize = 0;
+    std::span<SampleType> excitedBlock;
+    std::span<SampleType> mixGains;
+    std::span<SampleType*> wetChannels;     // One block per channel
+    std::span<SampleType*> chunkChannels;
+};
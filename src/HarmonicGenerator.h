@@ -4,49 +4,139 @@
 
 #pragma once
 
+#include <juce_dsp/juce_dsp.h>
+#include "SoftCeiling.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <vector>
 
+// Oversampling factor for the exciter's waveshaper, as a power of two
+enum class ExciterOversampling {
+    x1 = 0,
+    x2 = 1,
+    x4 = 2
+};
+
+template <typename SampleType>
 class HarmonicGenerator {
 public:
     HarmonicGenerator() = default;
 
+    using Oversampling = ExciterOversampling;
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    // Set up oversampling for processBlock(). linearPhase selects the
+    // equiripple FIR half-band filters (higher quality, more latency) instead
+    // of the polyphase IIR ones.
+    void prepare(int maxBlockSize, Oversampling factor, bool linearPhase) {
+        oversampler.reset();
+
+        if (factor != Oversampling::x1) {
+            const auto filterType = linearPhase
+                ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+                : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR;
+
+            // Integer latency so the dry path can be compensated exactly
+            oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(
+                1, static_cast<size_t>(factor), filterType, linearPhase, true);
+            oversampler->initProcessing(static_cast<size_t>(maxBlockSize));
+        }
+
+        maxBlock = maxBlockSize;
+        bypassDelay.assign(static_cast<size_t>(getLatencyInSamples()), SampleType(0));
+        warmUpBlock.assign(bypassDelay.size(), SampleType(0));
+        reset();
+    }
+
+    void reset() {
+        if (oversampler != nullptr) {
+            oversampler->reset();
+        }
+
+        std::fill(bypassDelay.begin(), bypassDelay.end(), SampleType(0));
+        bypassPosition = 0;
+        wasBypassed = false;
+    }
+
+    // Latency added by the oversampling filters, in base-rate samples
+    int getLatencyInSamples() const {
+        return oversampler != nullptr ? juce::roundToInt(oversampler->getLatencyInSamples()) : 0;
+    }
+
     // Set harmonic intensity (0-100)
     void setEnergy(float energyPercent) {
-        energy = juce::jlimit(0.0f, 100.0f, energyPercent) / 100.0f;
-        updateCoefficients();
+        setCoefficientInputs(juce::jlimit(0.0f, 100.0f, energyPercent) / 100.0f, harmonicProfile);
     }
 
     // Set harmonic profile (0.0-1.0, lighter to denser)
     void setHarmonicProfile(float profile) {
-        harmonicProfile = juce::jlimit(0.0f, 1.0f, profile);
-        updateCoefficients();
+        setCoefficientInputs(energy, juce::jlimit(0.0f, 1.0f, profile));
+    }
+
+    // Both at once; the coefficients are only recalculated when either changed,
+    // so this is cheap to call every sub-block
+    void setExcitation(float energyPercent, float profile) {
+        setCoefficientInputs(juce::jlimit(0.0f, 100.0f, energyPercent) / 100.0f, juce::jlimit(0.0f, 1.0f, profile));
     }
 
     // Process single sample
-    float processSample(float input) {
-        if (energy < 0.001f) {
+    SampleType processSample(SampleType input) {
+        if (energy < bypassEnergy) {
             // Phase-neutral bypass when ENERGY = 0
             return input;
         }
 
-        // Soft-knee waveshaper with even-dominant harmonics
-        // y = x + a*x^2 + b*tanh(x) + c*x^3
+        return transferCurve(input, evenCoeff, oddCoeff);
+    }
 
-        float x = input;
+    // Process a block in place, running the waveshaper at the oversampled rate.
+    // numSamples must not exceed the maxBlockSize passed to prepare().
+    void processBlock(SampleType* samples, int numSamples) {
+        shapeOversampled(samples, numSamples, acquireCurveTable());
+    }
 
-        // Even harmonics (x^2) - dominant
-        float evenHarm = evenCoeff * x * x * juce::dsp::FastMathApproximations::tanh(x);
+    // The exciter followed by SoftCeiling, as one stage. At 1x with the exact
+    // curve both run in the same pass over each register; otherwise the
+    // ceiling runs on the shaped (downsampled) block. Returns the ceiling's
+    // lowest gain, as SoftCeiling::processBlock() does.
+    SampleType processBlockWithCeiling(SampleType* samples, int numSamples) {
+        const CurveTable* table = acquireCurveTable();
 
-        // Odd harmonics (x^3, tanh) - very light presence
-        float oddHarm = oddCoeff * (x * x * x * 0.1f + juce::dsp::FastMathApproximations::tanh(x * 1.5f) * 0.05f);
+        if (oversampler == nullptr && table == nullptr && energy >= bypassEnergy) {
+            return shapeExact<true>(samples, static_cast<size_t>(numSamples));
+        }
 
-        // Combine
-        float output = x + evenHarm + oddHarm;
+        shapeOversampled(samples, numSamples, table);
+        return SoftCeiling<SampleType>::processBlock(samples, numSamples);
+    }
 
-        // Soft clip to prevent harsh peaks
-        output = juce::dsp::FastMathApproximations::tanh(output * 0.9f);
+    //==============================================================================
+    // Lookup-table mode: the whole transfer curve, soft clip included, is baked
+    // into an interpolated table. Tables are built off the audio thread with
+    // buildCurveTable() and picked up lock-free by processBlock(). Until a table
+    // matching the current ENERGY/profile arrives, the exact curve is used.
+    void setUseLookupTable(bool shouldUseTable) {
+        useLookupTable = shouldUseTable;
+    }
 
-        return output;
+    // Call from a single non-audio thread (e.g. the message thread)
+    void buildCurveTable(float energyPercent, float profile) {
+        const auto c = calculateCoefficients(juce::jlimit(0.0f, 100.0f, energyPercent) / 100.0f,
+                                             juce::jlimit(0.0f, 1.0f, profile));
+
+        // Three slots: the one the audio thread is using, the one last published
+        // (which it may be switching to right now), and a free one to write
+        const int active = activeTable.load(std::memory_order_acquire);
+        int slot = 0;
+        while (slot == active || slot == lastPublishedTable) {
+            ++slot;
+        }
+
+        curveTables[static_cast<size_t>(slot)].build(c.even, c.odd);
+        pendingTable.store(slot, std::memory_order_release);
+        lastPublishedTable = slot;
     }
 
 private:
@@ -56,21 +146,316 @@ private:
     float evenCoeff = 0.0f;         // Even harmonic coefficient
     float oddCoeff = 0.0f;          // Odd harmonic coefficient
 
-    void updateCoefficients() {
+    // Below this ENERGY (0-1) the exciter is bypassed
+    static constexpr float bypassEnergy = 0.001f;
+
+    static constexpr int lanes = static_cast<int>(Vec::size());
+
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler;   // null at 1x
+
+    // The input's last getLatencyInSamples() samples, which stand in for the
+    // oversampler's output while the exciter is bypassed
+    std::vector<SampleType> bypassDelay;
+    std::vector<SampleType> warmUpBlock;    // bypassDelay in order, for warmUpOversampler()
+    size_t bypassPosition = 0;
+    bool wasBypassed = false;
+    int maxBlock = 1;
+
+    struct Coefficients {
+        float even;
+        float odd;
+    };
+
+    static Coefficients calculateCoefficients(float energy01, float profile) {
         // Logarithmic scaling for more natural feel
-        float energyScaled = std::pow(energy, 1.5f);
+        float energyScaled = std::pow(energy01, 1.5f);
 
         // Even harmonics: dominant, increases with energy
         // Profile affects intensity (Studio=lighter, SoundSystem=denser)
-        evenCoeff = energyScaled * (0.2f + harmonicProfile * 0.3f);
+        float even = energyScaled * (0.2f + profile * 0.3f);
 
         // Odd harmonics: very light, only at higher energy levels
         // Threshold: only appears above 40% energy for Sound System mode
-        float oddThreshold = (harmonicProfile > 0.6f && energy > 0.4f) ? energy - 0.4f : 0.0f;
-        oddCoeff = oddThreshold * 0.15f * harmonicProfile;
+        float oddThreshold = (profile > 0.6f && energy01 > 0.4f) ? energy01 - 0.4f : 0.0f;
+        float odd = oddThreshold * 0.15f * profile;
 
         // Cap to prevent harshness
-        evenCoeff = juce::jlimit(0.0f, 0.5f, evenCoeff);
-        oddCoeff = juce::jlimit(0.0f, 0.12f, oddCoeff);
+        return { juce::jlimit(0.0f, 0.5f, even), juce::jlimit(0.0f, 0.12f, odd) };
     }
+
+    void setCoefficientInputs(float newEnergy, float newProfile) {
+        if (juce::exactlyEqual(newEnergy, energy) && juce::exactlyEqual(newProfile, harmonicProfile)) {
+            return;
+        }
+
+        energy = newEnergy;
+        harmonicProfile = newProfile;
+        updateCoefficients();
+    }
+
+    void updateCoefficients() {
+        const auto c = calculateCoefficients(energy, harmonicProfile);
+        evenCoeff = c.even;
+        oddCoeff = c.odd;
+    }
+
+    static SampleType transferCurve(SampleType x, float evenAmount, float oddAmount) {
+        // Soft-knee waveshaper with even-dominant harmonics
+        // y = x + a*x^2 + b*tanh(x) + c*x^3
+        const auto even = static_cast<SampleType>(evenAmount);
+        const auto odd = static_cast<SampleType>(oddAmount);
+
+        // Even harmonics (x^2) - dominant
+        SampleType evenHarm = even * x * x * juce::dsp::FastMathApproximations::tanh(x);
+
+        // Odd harmonics (x^3, tanh) - very light presence
+        SampleType oddHarm = odd * (x * x * x * SampleType(0.1) + juce::dsp::FastMathApproximations::tanh(x * SampleType(1.5)) * SampleType(0.05));
+
+        // Combine
+        SampleType output = x + evenHarm + oddHarm;
+
+        // Soft clip to prevent harsh peaks
+        return juce::dsp::FastMathApproximations::tanh(output * SampleType(0.9));
+    }
+
+    // transferCurve() across a register, in the same order of operations.
+    // The odd terms are skipped while their coefficient is zero, which adds
+    // nothing to the scalar curve either.
+    static Vec transferCurve(Vec x, SampleType even, SampleType odd, bool withOdd) {
+        Vec output = x + Vec::expand(even) * x * x * tanh(x);
+
+        if (withOdd) {
+            output += Vec::expand(odd) * (x * x * x * SampleType(0.1) + tanh(x * SampleType(1.5)) * SampleType(0.05));
+        }
+
+        return tanh(output * SampleType(0.9));
+    }
+
+    // FastMathApproximations::tanh's Pade approximant, with the division as a
+    // reciprocal, since SIMDRegister has none
+    static Vec tanh(Vec x) {
+        const Vec x2 = x * x;
+        const Vec numerator = x * (Vec::expand(SampleType(135135)) + x2 * (Vec::expand(SampleType(17325))
+                                   + x2 * (Vec::expand(SampleType(378)) + x2)));
+        const Vec denominator = Vec::expand(SampleType(135135)) + x2 * (Vec::expand(SampleType(62370))
+                                    + x2 * (Vec::expand(SampleType(3150)) + x2 * SampleType(28)));
+        return numerator * reciprocal(denominator);
+    }
+
+    // Newton-Raphson from a bit-pattern seed (within 5%): 3 steps reach float
+    // rounding, 4 double's. The denominator above is always >= 135135.
+    static Vec reciprocal(Vec d) {
+        using Bits = typename Vec::vMaskType;
+        using BitsElement = typename Bits::ElementType;
+
+        constexpr auto seed = sizeof(SampleType) == sizeof(float) ? BitsElement(0x7ef311c7u)
+                                                                  : BitsElement(0x7fde623822fc16e6ull);
+        constexpr int steps = sizeof(SampleType) == sizeof(float) ? 3 : 4;
+
+        Bits bits;
+        std::memcpy(&bits, &d, sizeof(Vec));
+        bits = Bits::expand(seed) - bits;
+
+        Vec r;
+        std::memcpy(&r, &bits, sizeof(Vec));
+
+        for (int step = 0; step < steps; ++step) {
+            r = r * (Vec::expand(SampleType(2)) - d * r);
+        }
+
+        return r;
+    }
+
+    //==============================================================================
+    struct CurveTable {
+        // Covers +/-4 (about +18 dBFS after the -6 dB pre-attenuation); inputs
+        // outside fall back to the exact curve
+        static constexpr SampleType range = 4;
+        static constexpr int numIntervals = 2048;
+        static constexpr SampleType scale = numIntervals / (2 * range);
+
+        float even = -1.0f;     // Coefficients the table was built for (-1 = never built)
+        float odd = -1.0f;
+        std::array<SampleType, numIntervals + 1> values {};
+
+        void build(float newEven, float newOdd) {
+            for (int i = 0; i <= numIntervals; ++i) {
+                const SampleType x = static_cast<SampleType>(i) / scale - range;
+                values[static_cast<size_t>(i)] = transferCurve(x, newEven, newOdd);
+            }
+
+            even = newEven;
+            odd = newOdd;
+        }
+
+        SampleType lookup(SampleType x) const {
+            if (! (std::abs(x) < range)) {
+                return transferCurve(x, even, odd);
+            }
+
+            const SampleType position = (x + range) * scale;
+            const auto index = std::min(static_cast<size_t>(position), static_cast<size_t>(numIntervals - 1));
+            const SampleType frac = position - static_cast<SampleType>(index);
+            return values[index] + frac * (values[index + 1] - values[index]);
+        }
+    };
+
+    // Audio thread: pick up a newly published table, and return the active one
+    // if it matches the current coefficients
+    const CurveTable* acquireCurveTable() {
+        const int pending = pendingTable.exchange(-1, std::memory_order_acq_rel);
+
+        if (pending >= 0) {
+            currentTable = pending;
+            activeTable.store(pending, std::memory_order_release);
+        }
+
+        if (! useLookupTable || currentTable < 0) {
+            return nullptr;
+        }
+
+        const auto& table = curveTables[static_cast<size_t>(currentTable)];
+        const bool matches = juce::exactlyEqual(table.even, evenCoeff) && juce::exactlyEqual(table.odd, oddCoeff);
+        return matches ? &table : nullptr;
+    }
+
+    void shapeOversampled(SampleType* samples, int numSamples, const CurveTable* table) {
+        if (oversampler == nullptr) {
+            shapeBlock(samples, static_cast<size_t>(numSamples), table);
+            return;
+        }
+
+        // Bypassed, the half-band filters alone would still phase-shift the
+        // block (the IIR ones in the realtime tier), so they are skipped and
+        // the block only delayed by their latency, staying aligned with the
+        // dry path
+        const bool bypassed = energy < bypassEnergy;
+
+        if (wasBypassed && ! bypassed) {
+            warmUpOversampler();
+        }
+
+        delayForBypass(samples, numSamples, bypassed);
+        wasBypassed = bypassed;
+
+        if (bypassed) {
+            return;
+        }
+
+        SampleType* channels[] = { samples };
+        juce::dsp::AudioBlock<SampleType> block(channels, 1, static_cast<size_t>(numSamples));
+
+        auto upsampled = oversampler->processSamplesUp(block);
+        shapeBlock(upsampled.getChannelPointer(0), upsampled.getNumSamples(), table);
+
+        oversampler->processSamplesDown(block);
+    }
+
+    // Back from bypass: restart the filters from silence on the input they
+    // missed most recently, held in bypassDelay, so their output carries on
+    // from the delayed block without a gap
+    void warmUpOversampler() {
+        oversampler->reset();
+        std::rotate_copy(bypassDelay.begin(), bypassDelay.begin() + static_cast<std::ptrdiff_t>(bypassPosition),
+                         bypassDelay.end(), warmUpBlock.begin());
+
+        for (size_t done = 0; done < warmUpBlock.size(); done += static_cast<size_t>(maxBlock)) {
+            SampleType* channels[] = { warmUpBlock.data() + done };
+            juce::dsp::AudioBlock<SampleType> block(channels, 1, juce::jmin(static_cast<size_t>(maxBlock), warmUpBlock.size() - done));
+
+            oversampler->processSamplesUp(block);
+            oversampler->processSamplesDown(block);
+        }
+    }
+
+    // Feeds the block through bypassDelay, always, so it holds the latest
+    // input whenever bypass begins; with replace, the block becomes its output
+    void delayForBypass(SampleType* samples, int numSamples, bool replace) {
+        const size_t length = bypassDelay.size();
+
+        if (length == 0) {
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i) {
+            const SampleType delayed = bypassDelay[bypassPosition];
+            bypassDelay[bypassPosition] = samples[i];
+            bypassPosition = bypassPosition + 1 < length ? bypassPosition + 1 : 0;
+
+            if (replace) {
+                samples[i] = delayed;
+            }
+        }
+    }
+
+    void shapeBlock(SampleType* samples, size_t numSamples, const CurveTable* table) const {
+        if (energy < bypassEnergy) {
+            // Phase-neutral bypass when ENERGY = 0
+            return;
+        }
+
+        if (table != nullptr) {
+            for (size_t i = 0; i < numSamples; ++i) {
+                samples[i] = table->lookup(samples[i]);
+            }
+        } else {
+            shapeExact<false>(samples, numSamples);
+        }
+    }
+
+    // The exact curve a register at a time, the remainder through a
+    // zero-padded register so every sample sees the same arithmetic. With
+    // the ceiling, it follows the curve in the same pass and its lowest gain
+    // is returned; without, the result is 1.
+    template <bool withCeiling>
+    SampleType shapeExact(SampleType* samples, size_t numSamples) const {
+        const auto even = static_cast<SampleType>(evenCoeff);
+        const auto odd = static_cast<SampleType>(oddCoeff);
+        const bool withOdd = oddCoeff > 0.0f;
+
+        auto shapedPeak = Vec::expand(SampleType(0));
+        auto limitedPeak = shapedPeak;
+
+        auto process = [&](Vec v) {
+            v = transferCurve(v, even, odd, withOdd);
+
+            if constexpr (withCeiling) {
+                shapedPeak = Vec::max(shapedPeak, Vec::abs(v));
+                v = SoftCeiling<SampleType>::processRegister(v);
+                limitedPeak = Vec::max(limitedPeak, Vec::abs(v));
+            }
+
+            return v;
+        };
+
+        size_t i = 0;
+
+        for (; i + lanes <= numSamples; i += lanes) {
+            Vec v;
+            std::memcpy(&v, samples + i, sizeof(Vec));
+            v = process(v);
+            std::memcpy(samples + i, &v, sizeof(Vec));
+        }
+
+        if (i < numSamples) {
+            const auto remaining = (numSamples - i) * sizeof(SampleType);
+            auto v = Vec::expand(SampleType(0));
+            std::memcpy(&v, samples + i, remaining);
+            v = process(v);
+            std::memcpy(samples + i, &v, remaining);
+        }
+
+        if constexpr (withCeiling) {
+            return SoftCeiling<SampleType>::gainBetween(shapedPeak, limitedPeak);
+        } else {
+            return SampleType(1);
+        }
+    }
+
+    bool useLookupTable = false;
+    std::array<CurveTable, 3> curveTables;
+    std::atomic<int> pendingTable { -1 };   // Published by buildCurveTable(), -1 = none
+    std::atomic<int> activeTable { -1 };    // Slot the audio thread is reading
+    int currentTable = -1;                  // Audio thread's copy of activeTable
+    int lastPublishedTable = -1;            // Builder thread only
 };
@@ -0,0 +1,276 @@
+// LookaheadLimiter.h
+// FIELD — Projection Engine
+// True-peak lookahead limiter: an alternative to SoftCeiling for hot material
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "DelayLine.h"
+#include "DspArena.h"
+#include "OutputMeter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <span>
+
+/**
+ * Holds the excited signal under the ceiling, inter-sample peaks included,
+ * by looking ahead instead of clipping.
+ *
+ * Each sample's peak is estimated as in BS.1770 true peak (OutputMeter's 4x
+ * polyphase FIR), turned into the gain that would keep it at the ceiling,
+ * and the lowest such gain over the lookahead window is tracked with a
+ * monotonic deque: O(1) per sample, whatever the window length. That gain
+ * releases exponentially and is then averaged over the lookahead, so the gain
+ * reaches every peak's requirement by the time the delayed peak arrives,
+ * along a straight ramp rather than a step.
+ *
+ * A peak's requirement is held over all 12 samples its estimate was
+ * interpolated from, not just the two it lies between: the output's own
+ * inter-sample peaks are drawn from those same samples, and a ramp still
+ * running across them would let the limited signal overshoot. Gains that
+ * still differ across a span, under several peaks, can lift those peaks by
+ * a few parts in 1e5, so peaks are held 0.01 dB under the ceiling.
+ *
+ * Blocks with no peak over the ceiling and no reduction still pending take a
+ * per-block path: the delay alone, with no gain maths.
+ *
+ * Latency is the lookahead plus the detector filter's span; the owner
+ * delays its dry path to match and reports it to the host.
+ */
+template <typename SampleType>
+class LookaheadLimiter {
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+    using Meter = OutputMeter<SampleType>;
+
+    static constexpr float minLookaheadMs = 0.5f;
+    static constexpr float maxLookaheadMs = 5.0f;
+    static constexpr float defaultLookaheadMs = 1.5f;
+
+    // Same level as SoftCeiling's threshold, so switching keeps the same headroom
+    static constexpr SampleType ceiling = SampleType(0.891);
+
+    LookaheadLimiter() {
+        for (int tap = 0; tap < Meter::tapsPerPhase; ++tap) {
+            for (int phase = 0; phase < Meter::numPhaseRegisters * Meter::lanesPerRegister; ++phase) {
+                const double c = phase < Meter::numPhases ? Meter::coefficients[phase][tap] : 0.0;
+                phaseCoefficients[static_cast<size_t>(tap)][static_cast<size_t>(phase / Meter::lanesPerRegister)]
+                    .set(static_cast<size_t>(phase % Meter::lanesPerRegister), static_cast<SampleType>(c));
+            }
+        }
+    }
+
+    // lookaheadMs is clamped to 0.5-5 ms
+    void prepare(double sampleRate, float lookaheadMs, int maxBlockSize, DspArena& arena) {
+        lookahead = juce::jmax(1, juce::roundToInt(sampleRate * juce::jlimit(minLookaheadMs, maxLookaheadMs, lookaheadMs) / 1000.0));
+        windowLength = lookahead + detectorSpan;
+
+        delay.prepare(sampleRate, static_cast<float>((getLatencySamples() + 1) * 1000.0 / sampleRate), maxBlockSize, arena);
+        staging = arena.allocate<SampleType>(static_cast<size_t>(historyLength + maxBlockSize));
+        gains = arena.allocate<SampleType>(static_cast<size_t>(maxBlockSize));
+        smoothing = arena.allocate<SampleType>(static_cast<size_t>(lookahead));
+        window = arena.allocate<Entry>(static_cast<size_t>(windowLength));
+
+        if (arena.isMeasuring()) {
+            return;
+        }
+
+        delay.setDelaySamples(getLatencySamples());
+        releaseCoefficient = static_cast<SampleType>(1.0 - std::exp(-1.0 / (releaseTimeSeconds * sampleRate)));
+        reset();
+    }
+
+    void reset() {
+        delay.reset();
+        std::fill(staging.begin(), staging.end(), SampleType(0));
+        std::fill(smoothing.begin(), smoothing.end(), SampleType(1));
+
+        position = 0;
+        windowStart = windowSize = 0;
+        released = SampleType(1);
+        smoothingSum = static_cast<double>(lookahead);
+        smoothingIndex = 0;
+        samplesSinceReduction = lookahead;
+    }
+
+    // Lookahead plus the detector's span, in samples
+    int getLatencySamples() const { return lookahead + detectorSpan - 1; }
+
+    // Time for the deepest reduction to play out entirely: its hold over the
+    // window, the release down to its snap, then the lookahead's moving
+    // average. Input older than this no longer affects the gain.
+    static double getSettlingSeconds(double sampleRate, float lookaheadMs) {
+        const double lookaheadSeconds = juce::jlimit(minLookaheadMs, maxLookaheadMs, lookaheadMs) / 1000.0;
+
+        return 2.0 * lookaheadSeconds + detectorSpan / sampleRate
+             + releaseTimeSeconds * std::log(1.0 / static_cast<double>(releaseSnap));
+    }
+
+    // Limit numSamples in place, delayed by getLatencySamples(). Returns the
+    // lowest gain applied. numSamples must not exceed the prepared maxBlockSize.
+    SampleType process(SampleType* samples, int numSamples) {
+        const SampleType blockPeak = detectPeaks(samples, numSamples);
+
+        delay.processBlock(samples, samples, numSamples);
+
+        // Nothing over the ceiling, and every earlier reduction has played
+        // out: unity gain for the whole block
+        if (blockPeak <= target && windowSize == 0 && samplesSinceReduction >= lookahead
+            && released >= SampleType(1)) {
+            position += static_cast<size_t>(numSamples);
+            smoothingIndex = (smoothingIndex + numSamples) % lookahead;
+            return SampleType(1);
+        }
+
+        SampleType* gain = gains.data();
+        SampleType lowest = SampleType(1);
+        const double scale = 1.0 / static_cast<double>(lookahead);
+
+        for (int i = 0; i < numSamples; ++i, ++position) {
+            // gain[] holds each sample's detected peak until replaced by its gain
+            const SampleType required = gain[i] > target ? target / gain[i] : SampleType(1);
+            const SampleType lowestInWindow = slideWindow(required);
+
+            // Instant attack, exponential release
+            released = lowestInWindow < released ? lowestInWindow
+                                                 : released + (lowestInWindow - released) * releaseCoefficient;
+
+            // The last -0.0001 dB of a release snaps onto its target
+            if (released >= SampleType(1) - releaseSnap) {
+                released = lowestInWindow;
+            }
+
+            samplesSinceReduction = released < SampleType(1) ? 0 : samplesSinceReduction + 1;
+
+            // Moving average over the lookahead: a linear ramp into each reduction
+            SampleType& oldest = smoothing[static_cast<size_t>(smoothingIndex)];
+            smoothingSum += static_cast<double>(released) - static_cast<double>(oldest);
+            oldest = released;
+            smoothingIndex = smoothingIndex + 1 < lookahead ? smoothingIndex + 1 : 0;
+
+            gain[i] = juce::jmin(SampleType(1), static_cast<SampleType>(smoothingSum * scale));
+            lowest = juce::jmin(lowest, gain[i]);
+        }
+
+        // Back at unity: drop the running sum's rounding before it accumulates
+        if (samplesSinceReduction >= lookahead) {
+            smoothingSum = static_cast<double>(lookahead);
+        }
+
+        juce::FloatVectorOperations::multiply(samples, gain, numSamples);
+        return lowest;
+    }
+
+private:
+    struct Entry {
+        size_t position;
+        SampleType gain;
+    };
+
+    static constexpr int historyLength = Meter::tapsPerPhase - 1;
+
+    // What detected peaks are held to, 0.01 dB under the ceiling
+    static constexpr SampleType target = ceiling * SampleType(0.999);
+
+    // The FIR's phases interpolate between the samples 6 and 5 behind the
+    // newest, from all tapsPerPhase of them
+    static constexpr int detectorDelay = 6;
+    static constexpr int detectorSpan = Meter::tapsPerPhase;
+
+    static constexpr double releaseTimeSeconds = 0.05;
+    static constexpr SampleType releaseSnap = SampleType(1.0e-5);
+
+    // Writes each sample's true-peak estimate into gains and returns the
+    // block's highest
+    SampleType detectPeaks(const SampleType* samples, int numSamples) {
+        SampleType* input = staging.data() + historyLength;
+        std::copy(samples, samples + numSamples, input);
+
+        Vec blockPeak = Vec::expand(SampleType(0));
+
+        for (int i = 0; i < numSamples; ++i) {
+            std::array<Vec, Meter::numPhaseRegisters> phases;
+            phases.fill(Vec::expand(SampleType(0)));
+
+            for (int tap = 0; tap < Meter::tapsPerPhase; ++tap) {
+                const auto x = Vec::expand(input[i - tap]);
+
+                for (int r = 0; r < Meter::numPhaseRegisters; ++r) {
+                    phases[static_cast<size_t>(r)] += phaseCoefficients[static_cast<size_t>(tap)][static_cast<size_t>(r)] * x;
+                }
+            }
+
+            // The two samples either side of the interpolated ones, so the
+            // estimate is never below the sample peak
+            Vec peak = Vec::max(Vec::expand(std::abs(input[i - detectorDelay])),
+                                Vec::expand(std::abs(input[i - detectorDelay + 1])));
+
+            for (const auto& phase : phases) {
+                peak = Vec::max(peak, Vec::abs(phase));
+            }
+
+            gains[static_cast<size_t>(i)] = horizontalMax(peak);
+            blockPeak = Vec::max(blockPeak, peak);
+        }
+
+        std::memmove(staging.data(), staging.data() + numSamples, static_cast<size_t>(historyLength) * sizeof(SampleType));
+        return horizontalMax(blockPeak);
+    }
+
+    // Push this sample's required gain and return the lowest over the last
+    // windowLength samples. The deque keeps only gains below unity, rising
+    // from front to back; an empty deque means unity.
+    SampleType slideWindow(SampleType required) {
+        const auto capacity = static_cast<size_t>(windowLength);
+
+        // Expire first, so the ring never holds more than windowLength entries
+        while (windowSize > 0 && window[windowStart].position + capacity <= position) {
+            windowStart = (windowStart + 1) % capacity;
+            --windowSize;
+        }
+
+        if (required < SampleType(1)) {
+            while (windowSize > 0 && window[(windowStart + windowSize - 1) % capacity].gain >= required) {
+                --windowSize;
+            }
+
+            window[(windowStart + windowSize) % capacity] = { position, required };
+            ++windowSize;
+        }
+
+        return windowSize > 0 ? window[windowStart].gain : SampleType(1);
+    }
+
+    static SampleType horizontalMax(Vec v) {
+        SampleType result = v.get(0);
+
+        for (size_t i = 1; i < Vec::size(); ++i) {
+            result = juce::jmax(result, v.get(i));
+        }
+
+        return result;
+    }
+
+    std::array<std::array<Vec, Meter::numPhaseRegisters>, Meter::tapsPerPhase> phaseCoefficients;
+
+    int lookahead = 1;          // Samples; also the length of the gain ramp
+    int windowLength = 13;      // lookahead + detectorSpan: every sample a detected peak is drawn from
+
+    DelayLine<SampleType> delay;
+    std::span<SampleType> staging;      // historyLength samples of the previous block, then this one
+    std::span<SampleType> gains;        // Detected peaks, then gains, for one block
+    std::span<SampleType> smoothing;    // The last lookahead released gains
+    std::span<Entry> window;            // Monotonic deque, as a ring of windowLength entries
+
+    size_t position = 0;                // Samples processed since reset()
+    size_t windowStart = 0;
+    size_t windowSize = 0;
+    SampleType released = SampleType(1);
+    SampleType releaseCoefficient = SampleType(0);
+    double smoothingSum = 1.0;
+    int smoothingIndex = 0;
+    int samplesSinceReduction = 0;
+};
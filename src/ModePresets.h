@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include "ConstexprMath.h"
+
+#include <algorithm>
 #include <array>
 
 namespace ModePresets {
@@ -15,16 +18,23 @@ struct TapConfig {
     float gainDb;       // Tap gain in dB
 };
 
-struct ModeConfig {
-    std::array<TapConfig, 6> taps;
+// A mode's settings with a field of NumTaps taps
+template <size_t NumTaps>
+struct FieldConfig {
+    std::array<TapConfig, NumTaps> taps;
     float harmonicProfile;      // Harmonic character: 0.0-1.0 (Studio=lighter, SoundSystem=denser)
     float compensationTrim;     // Level matching trim in dB (calibrated)
     const char* name;
 };
 
+// The hand-tuned modes below
+inline constexpr size_t defaultNumTaps = 6;
+
+using ModeConfig = FieldConfig<defaultNumTaps>;
+
 // STUDIO MODE
 // Tighter delays, air-focused, no low-mid reinforcement
-inline const ModeConfig STUDIO = {
+inline constexpr ModeConfig STUDIO = {
     .taps = {{
         {6.0f,  -15.0f, 9500.0f, -12.0f},   // Tap 1
         {11.0f,  15.0f, 8500.0f, -13.5f},   // Tap 2
@@ -40,7 +50,7 @@ inline const ModeConfig STUDIO = {
 
 // SOUND SYSTEM MODE
 // Wider delays, low-mid density increase when ENERGY > 40%
-inline const ModeConfig SOUND_SYSTEM = {
+inline constexpr ModeConfig SOUND_SYSTEM = {
     .taps = {{
         {8.0f,  -20.0f, 7000.0f, -11.0f},   // Tap 1
         {15.0f,  20.0f, 6200.0f, -12.5f},   // Tap 2
@@ -55,8 +65,111 @@ inline const ModeConfig SOUND_SYSTEM = {
 };
 
 // Helper to get mode by index
-inline const ModeConfig& getMode(int index) {
+constexpr const ModeConfig& getMode(int index) {
     return (index == 0) ? STUDIO : SOUND_SYSTEM;
 }
 
+inline constexpr std::array<const ModeConfig*, 2> allModes = {&STUDIO, &SOUND_SYSTEM};
+
+//==============================================================================
+namespace detail {
+
+inline constexpr double nepersPerDb = ConstexprMath::ln10 / 10.0;   // Power ratio
+
+// Summed linear power of a field's tap gains
+template <size_t NumTaps>
+constexpr double getTapPower(const std::array<TapConfig, NumTaps>& taps) {
+    double power = 0.0;
+    for (const auto& tap : taps)
+        power += ConstexprMath::exp(static_cast<double>(tap.gainDb) * nepersPerDb);
+    return power;
+}
+
+constexpr float lerp(float a, float b, double t) {
+    return static_cast<float>(a + (b - a) * t);
+}
+
+} // namespace detail
+
+// A denser field spanning the same space as a hand-tuned mode: NumTaps taps
+// interpolated along its delays, cutoffs, gains and pan widths, alternating
+// sides as the original does, then trimmed to the original's summed tap power
+template <size_t NumTaps>
+constexpr FieldConfig<NumTaps> makeDenseField(const ModeConfig& base) {
+    static_assert(NumTaps >= 2);
+
+    FieldConfig<NumTaps> field { {}, base.harmonicProfile, base.compensationTrim, base.name };
+
+    for (size_t i = 0; i < NumTaps; ++i) {
+        const double position = static_cast<double>(i) * (defaultNumTaps - 1) / static_cast<double>(NumTaps - 1);
+        const auto lower = std::min(static_cast<size_t>(position), defaultNumTaps - 2);
+        const double t = position - static_cast<double>(lower);
+        const auto& a = base.taps[lower];
+        const auto& b = base.taps[lower + 1];
+
+        const float width = detail::lerp(a.pan < 0.0f ? -a.pan : a.pan, b.pan < 0.0f ? -b.pan : b.pan, t);
+        const bool left = (base.taps[0].pan < 0.0f) == (i % 2 == 0);
+
+        field.taps[i] = {
+            detail::lerp(a.delayMs, b.delayMs, t),
+            left ? -width : width,
+            detail::lerp(a.lpCutoff, b.lpCutoff, t),
+            detail::lerp(a.gainDb, b.gainDb, t)
+        };
+    }
+
+    const auto trimDb = static_cast<float>(ConstexprMath::log(detail::getTapPower(base.taps) / detail::getTapPower(field.taps))
+                                           / detail::nepersPerDb);
+
+    for (auto& tap : field.taps)
+        tap.gainDb += trimDb;
+
+    return field;
+}
+
+// The hand-tuned modes at NumTaps taps: the originals at defaultNumTaps,
+// denser fields derived from them otherwise
+template <size_t NumTaps>
+inline constexpr std::array<FieldConfig<NumTaps>, 2> denseModes = {
+    makeDenseField<NumTaps>(STUDIO), makeDenseField<NumTaps>(SOUND_SYSTEM)
+};
+
+template <size_t NumTaps>
+constexpr const FieldConfig<NumTaps>& getField(int index) {
+    if constexpr (NumTaps == defaultNumTaps)
+        return getMode(index);
+    else
+        return denseModes<NumTaps>[(index == 0) ? 0 : 1];
+}
+
+//==============================================================================
+// Longest tap delay across all modes (sizes the shared tap history). Denser
+// fields interpolate between these delays, so it holds for them too.
+constexpr float getMaxDelayMs() {
+    float maxDelay = 0.0f;
+    for (const auto* mode : allModes)
+        for (const auto& tap : mode->taps)
+            maxDelay = std::max(maxDelay, tap.delayMs);
+    return maxDelay;
+}
+
+inline constexpr float maxDelayMs = getMaxDelayMs();
+
+// Time for a tap's low-pass ring-out to fall by 120 dB. The Butterworth
+// poles decay at 2*pi*fc/sqrt(2) nepers/s, and 120 dB is ln(1e6) nepers.
+constexpr float getFilterDecayMs(float cutoffHz) {
+    constexpr float nepers120dB = 13.8155f;
+    constexpr float twoPiOverSqrt2 = 4.44288f;
+    return nepers120dB / (twoPiOverSqrt2 * cutoffHz) * 1000.0f;
+}
+
+// How long the tap field keeps ringing after the input stops
+template <size_t NumTaps>
+constexpr float getTailMs(const FieldConfig<NumTaps>& mode) {
+    float tail = 0.0f;
+    for (const auto& tap : mode.taps)
+        tail = std::max(tail, tap.delayMs + getFilterDecayMs(tap.lpCutoff));
+    return tail;
+}
+
 } // namespace ModePresets
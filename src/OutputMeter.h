@@ -0,0 +1,152 @@
+// OutputMeter.h
+// FIELD — Projection Engine
+// Sample peak, RMS and 4x oversampled true peak of one output channel
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "DspArena.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <span>
+
+/**
+ * Measures a channel as it is written by the output stage.
+ *
+ * The writer hands over each mixed register of samples with accumulate(),
+ * which folds it into SIMD peak and sum-of-squares registers and stages it
+ * for the true-peak filter; finishChunk() then runs the filter over the
+ * staged samples while they are still in cache.
+ *
+ * True peak follows ITU-R BS.1770-4 Annex 2: 4x upsampling with the 48-tap
+ * polyphase FIR given there, evaluated as four 12-tap phases side by side
+ * in SIMD lanes.
+ */
+template <typename SampleType>
+class OutputMeter {
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int lanesPerRegister = static_cast<int>(Vec::size());
+    static constexpr int numPhases = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int numPhaseRegisters = (numPhases + lanesPerRegister - 1) / lanesPerRegister;
+
+    // ITU-R BS.1770-4, Annex 2, Table 1; also LookaheadLimiter's peak detector
+    static constexpr double coefficients[numPhases][tapsPerPhase] = {
+        {  0.0017089843750,  0.0109863281250, -0.0196533203125,  0.0332031250000,
+          -0.0594482421875,  0.1373291015625,  0.9721679687500, -0.1022949218750,
+           0.0476074218750, -0.0266113281250,  0.0148925781250, -0.0083007812500 },
+        { -0.0291748046875,  0.0292968750000, -0.0517578125000,  0.0891113281250,
+          -0.1665039062500,  0.4650878906250,  0.7797851562500, -0.2003173828125,
+           0.1015625000000, -0.0582275390625,  0.0330810546875, -0.0189208984375 },
+        { -0.0189208984375,  0.0330810546875, -0.0582275390625,  0.1015625000000,
+          -0.2003173828125,  0.7797851562500,  0.4650878906250, -0.1665039062500,
+           0.0891113281250, -0.0517578125000,  0.0292968750000, -0.0291748046875 },
+        { -0.0083007812500,  0.0148925781250, -0.0266113281250,  0.0476074218750,
+          -0.1022949218750,  0.9721679687500,  0.1373291015625, -0.0594482421875,
+           0.0332031250000, -0.0196533203125,  0.0109863281250,  0.0017089843750 }
+    };
+
+    OutputMeter() {
+        for (int tap = 0; tap < tapsPerPhase; ++tap) {
+            for (int phase = 0; phase < numPhaseRegisters * lanesPerRegister; ++phase) {
+                const double c = phase < numPhases ? coefficients[static_cast<size_t>(phase)][static_cast<size_t>(tap)] : 0.0;
+                phaseCoefficients[static_cast<size_t>(tap)][static_cast<size_t>(phase / lanesPerRegister)]
+                    .set(static_cast<size_t>(phase % lanesPerRegister), static_cast<SampleType>(c));
+            }
+        }
+
+        beginBlock();
+    }
+
+    void prepare(int maxBlockSize, DspArena& arena) {
+        staging = arena.allocate<SampleType>(static_cast<size_t>(historyLength + maxBlockSize));
+        reset();
+    }
+
+    // Clears the true-peak filter history
+    void reset() {
+        std::fill(staging.begin(), staging.end(), SampleType(0));
+        beginBlock();
+    }
+
+    // Start measuring a new host block
+    void beginBlock() {
+        peak = sumSquares = truePeak = Vec::expand(SampleType(0));
+        numMeasured = 0;
+    }
+
+    // Samples [index, index + lanesPerRegister) of the current chunk
+    void accumulate(Vec samples, int index) {
+        peak = Vec::max(peak, Vec::abs(samples));
+        sumSquares += samples * samples;
+        std::memcpy(staging.data() + historyLength + index, &samples, sizeof(Vec));
+    }
+
+    // Odd samples at the end of a chunk
+    void accumulate(SampleType sample, int index) {
+        const auto samples = Vec::expand(sample);
+        peak = Vec::max(peak, Vec::abs(samples));
+        sumSquares.set(0, sumSquares.get(0) + sample * sample);
+        staging[static_cast<size_t>(historyLength + index)] = sample;
+    }
+
+    // Run the true-peak filter over the chunk just accumulated
+    void finishChunk(int numSamples) {
+        const SampleType* input = staging.data() + historyLength;
+
+        for (int i = 0; i < numSamples; ++i) {
+            std::array<Vec, numPhaseRegisters> phases;
+            phases.fill(Vec::expand(SampleType(0)));
+
+            for (int tap = 0; tap < tapsPerPhase; ++tap) {
+                const auto x = Vec::expand(input[i - tap]);
+
+                for (int r = 0; r < numPhaseRegisters; ++r) {
+                    phases[static_cast<size_t>(r)] += phaseCoefficients[static_cast<size_t>(tap)][static_cast<size_t>(r)] * x;
+                }
+            }
+
+            for (const auto& phase : phases) {
+                truePeak = Vec::max(truePeak, Vec::abs(phase));
+            }
+        }
+
+        // Keep the last samples as history for the next chunk
+        std::memmove(staging.data(), staging.data() + numSamples, static_cast<size_t>(historyLength) * sizeof(SampleType));
+        numMeasured += numSamples;
+    }
+
+    SampleType getPeak() const { return horizontalMax(peak); }
+
+    SampleType getRMS() const {
+        return numMeasured > 0 ? std::sqrt(sumSquares.sum() / static_cast<SampleType>(numMeasured)) : SampleType(0);
+    }
+
+    // Never below the sample peak, which the filter only approximates
+    SampleType getTruePeak() const { return juce::jmax(horizontalMax(truePeak), getPeak()); }
+
+private:
+    static SampleType horizontalMax(Vec v) {
+        SampleType result = v.get(0);
+
+        for (size_t i = 1; i < Vec::size(); ++i) {
+            result = juce::jmax(result, v.get(i));
+        }
+
+        return result;
+    }
+
+    static constexpr int historyLength = tapsPerPhase - 1;
+
+    std::array<std::array<Vec, numPhaseRegisters>, tapsPerPhase> phaseCoefficients;
+
+    // historyLength samples of the previous chunk, then the current chunk
+    std::span<SampleType> staging;
+
+    Vec peak, sumSquares, truePeak;
+    int numMeasured = 0;
+};
@@ -0,0 +1,201 @@
+// PhaseScope.h
+// FIELD — Projection Engine
+// Goniometer and phase-correlation meter
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "ScopeFifo.h"
+
+/**
+ * Vectorscope of the output with a correlation meter beside it.
+ *
+ * Points arrive decimated through a ScopeFifo and are plotted mid-up,
+ * side-across into a single-channel image: mono is a vertical line, a
+ * polarity flip a horizontal one. Each tick first fades the image, so
+ * older points persist for a few frames. Correlation is the smoothed
+ * normalised L·R product of the same points; decimation leaves its
+ * expected value unchanged.
+ *
+ * Like StereoVisualization, there is no timer: the owner calls update()
+ * once per meter tick.
+ */
+class PhaseScope : public juce::Component {
+public:
+    PhaseScope() = default;
+
+    void paint(juce::Graphics& g) override {
+        // Static layers, rebuilt only when the size or display scale changes
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (backgroundCache.isNull() || ! juce::approximatelyEqual(scale, cacheScale)) {
+            renderBackground(scale);
+        }
+
+        g.drawImage(backgroundCache, getLocalBounds().toFloat());
+
+        // Trace, drawn through the current colour
+        g.setColour(accentBlue);
+        g.drawImage(trace, traceArea.toFloat(), juce::RectanglePlacement::stretchToFit, true);
+
+        // Correlation: a bar from the centre, warning colour when out of phase
+        const auto track = getCorrelationTrack();
+        const float markerX = getCorrelationX();
+        const float centreX = track.getCentreX();
+
+        g.setColour(correlation < 0.0f ? warnRed : accentBlue);
+        g.fillRoundedRectangle(juce::jmin(markerX, centreX), track.getY(), std::abs(markerX - centreX), track.getHeight(), 2.0f);
+        g.fillRoundedRectangle(markerX - 1.5f, track.getY() - 3.0f, 3.0f, track.getHeight() + 6.0f, 1.0f);
+
+        paintedCorrelationX = markerX;
+    }
+
+    void resized() override {
+        backgroundCache = {};
+
+        auto bounds = getLocalBounds().reduced(6);
+        traceArea = bounds.removeFromLeft(bounds.getHeight());
+        correlationArea = bounds.withTrimmedLeft(16);
+
+        trace = juce::Image(juce::Image::SingleChannel, juce::jmax(1, traceArea.getWidth()), juce::jmax(1, traceArea.getHeight()), true);
+        paintedCorrelationX = -1.0f;
+    }
+
+    // Fade the trace, plot everything that arrived since the last tick and
+    // update the correlation
+    void update(ScopeFifo& fifo) {
+        if (trace.isNull()) {
+            fifo.drain([](const ScopePoint&) {});
+            return;
+        }
+
+        if (framesSinceLastPoint < fadeOutFrames) {
+            trace.multiplyAllAlphas(persistence);
+        }
+
+        int numPoints = 0;
+
+        {
+            juce::Image::BitmapData pixels(trace, juce::Image::BitmapData::readWrite);
+
+            // ±1 on each channel fills the square
+            const float halfWidth = static_cast<float>(pixels.width - 1) * 0.5f;
+            const float halfHeight = static_cast<float>(pixels.height - 1) * 0.5f;
+
+            numPoints = fifo.drain([&](const ScopePoint& point) {
+                const float side = (point.right - point.left) * 0.5f;
+                const float mid = (point.left + point.right) * 0.5f;
+
+                const int x = juce::roundToInt(halfWidth + side * halfWidth);
+                const int y = juce::roundToInt(halfHeight - mid * halfHeight);
+
+                if (x >= 0 && x < pixels.width && y >= 0 && y < pixels.height) {
+                    auto* pixel = pixels.getPixelPointer(x, y);
+                    *pixel = static_cast<juce::uint8>(juce::jmin(255, *pixel + pointIntensity));
+                }
+
+                sumLR += correlationSmoothing * (point.left * point.right - sumLR);
+                sumLL += correlationSmoothing * (point.left * point.left - sumLL);
+                sumRR += correlationSmoothing * (point.right * point.right - sumRR);
+            });
+        }
+
+        // Silence has no phase; show it as uncorrelated
+        const float energy = sumLL * sumRR;
+        correlation = energy > 1.0e-12f ? juce::jlimit(-1.0f, 1.0f, sumLR / std::sqrt(energy)) : 0.0f;
+
+        // Keep repainting the trace until the last points have faded out
+        framesSinceLastPoint = numPoints > 0 ? 0 : framesSinceLastPoint + 1;
+
+        if (framesSinceLastPoint < fadeOutFrames) {
+            repaint(traceArea);
+        }
+
+        if (std::abs(getCorrelationX() - paintedCorrelationX) >= repaintThreshold) {
+            repaint(getCorrelationTrack().expanded(2.0f, 4.0f).getSmallestIntegerContainer());
+        }
+    }
+
+private:
+    // Layout
+    juce::Rectangle<int> traceArea;
+    juce::Rectangle<int> correlationArea;
+
+    // Persistent trace, one byte of intensity per pixel
+    juce::Image trace;
+    int framesSinceLastPoint = 0;
+
+    // Correlation, smoothed per point
+    float sumLR = 0.0f;
+    float sumLL = 0.0f;
+    float sumRR = 0.0f;
+    float correlation = 0.0f;
+    float paintedCorrelationX = -1.0f;
+
+    // Static layers at cacheScale
+    juce::Image backgroundCache;
+    float cacheScale = 1.0f;
+
+    // Constants
+    const float persistence = 0.8f;             // Trace intensity kept per tick
+    const int fadeOutFrames = 30;               // 0.8^30 * 255 < 1
+    const int pointIntensity = 96;
+    const float correlationSmoothing = 1.0f - std::exp(-1.0f / (0.3f * static_cast<float>(ScopeFifo::pointsPerSecond)));
+    const juce::Colour accentBlue = juce::Colour(0xFF4A90D9);
+    const juce::Colour warnRed = juce::Colour(0xFFD9534A);
+    const juce::Colour textLight = juce::Colour(0xFFE0E0E0);
+
+    static constexpr float trackHeight = 6.0f;
+    static constexpr float repaintThreshold = 0.5f;     // Pixels
+
+    juce::Rectangle<float> getCorrelationTrack() const {
+        return correlationArea.toFloat().withSizeKeepingCentre(static_cast<float>(correlationArea.getWidth()), trackHeight);
+    }
+
+    float getCorrelationX() const {
+        const auto track = getCorrelationTrack();
+        return track.getCentreX() + correlation * track.getWidth() * 0.5f;
+    }
+
+    void renderBackground(float scale) {
+        cacheScale = scale;
+        backgroundCache = juce::Image(juce::Image::ARGB,
+                                      juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                      juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                                      true);
+
+        juce::Graphics g(backgroundCache);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
+        auto bounds = getLocalBounds().toFloat();
+
+        // Background
+        g.setColour(juce::Colour(0xFF0A0A0A));
+        g.fillRoundedRectangle(bounds, 8.0f);
+
+        // Border
+        g.setColour(accentBlue.withAlpha(0.3f));
+        g.drawRoundedRectangle(bounds.reduced(1.0f), 8.0f, 1.5f);
+
+        // Goniometer axes: M vertical, S horizontal, L and R on the diagonals
+        const auto scope = traceArea.toFloat();
+        g.setColour(juce::Colour(0xFF333333));
+        g.drawLine(scope.getCentreX(), scope.getY(), scope.getCentreX(), scope.getBottom(), 1.0f);
+        g.drawLine(scope.getX(), scope.getCentreY(), scope.getRight(), scope.getCentreY(), 1.0f);
+        g.drawLine(scope.getX(), scope.getY(), scope.getRight(), scope.getBottom(), 0.5f);
+        g.drawLine(scope.getRight(), scope.getY(), scope.getX(), scope.getBottom(), 0.5f);
+
+        // Correlation track and scale
+        const auto track = getCorrelationTrack();
+        g.fillRoundedRectangle(track, 2.0f);
+
+        g.setColour(textLight.withAlpha(0.6f));
+        g.setFont(juce::Font(10.0f, juce::Font::bold));
+        g.drawText("L", scope.getX(), scope.getY(), 10, 10, juce::Justification::left);
+        g.drawText("R", scope.getRight() - 10, scope.getY(), 10, 10, juce::Justification::right);
+        g.drawText("CORRELATION", track.getX(), track.getY() - 24, track.getWidth(), 12, juce::Justification::centred);
+        g.drawText("-1", track.getX(), track.getBottom() + 6, 20, 10, juce::Justification::left);
+        g.drawText("0", track.getCentreX() - 10, track.getBottom() + 6, 20, 10, juce::Justification::centred);
+        g.drawText("+1", track.getRight() - 20, track.getBottom() + 6, 20, 10, juce::Justification::right);
+    }
+};
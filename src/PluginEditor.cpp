@@ -8,8 +8,11 @@
 FieldAudioProcessorEditor::FieldAudioProcessorEditor(FieldAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p)
 {
-    // Window size: 600x400
-    setSize(600, 400);
+    // Window size: 600x520 (controls, then meters and scope)
+    setSize(600, 520);
+
+    // paint() covers every pixel
+    setOpaque(true);
 
     // Title
     titleLabel.setText("FIELD — Projection Engine", juce::dontSendNotification);
@@ -65,16 +68,36 @@ FieldAudioProcessorEditor::FieldAudioProcessorEditor(FieldAudioProcessor& p)
     modeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.apvts, "mode", modeSelector);
 
-    // Stereo visualization
+    // Stereo visualization and phase scope, updated from vBlankAttachment
     addAndMakeVisible(stereoViz);
-
-    // Start timer for visualization updates (30 Hz)
-    startTimerHz(30);
+    addAndMakeVisible(phaseScope);
 }
 
 //==============================================================================
 void FieldAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    // Meter repaints land here too (the visualization is not opaque), so the
+    // background is drawn once per size and display scale and then blitted
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (backgroundCache.isNull() || ! juce::approximatelyEqual(scale, backgroundScale)) {
+        renderBackground(scale);
+    }
+
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+}
+
+void FieldAudioProcessorEditor::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    backgroundCache = juce::Image(juce::Image::RGB,
+                                  juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                  juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                                  false);
+
+    juce::Graphics g(backgroundCache);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // Background gradient
     g.fillAll(bgDark);
 
@@ -94,8 +117,13 @@ void FieldAudioProcessorEditor::paint(juce::Graphics& g)
 
 void FieldAudioProcessorEditor::resized()
 {
+    backgroundCache = {};
+
     auto bounds = getLocalBounds();
 
+    // Bottom area for the phase scope (120px)
+    phaseScope.setBounds(bounds.removeFromBottom(120).reduced(40, 10));
+
     // Header (40px)
     auto header = bounds.removeFromTop(40);
     titleLabel.setBounds(header.reduced(10));
@@ -110,24 +138,50 @@ void FieldAudioProcessorEditor::resized()
 
     // Left area for FIELD knob
     auto leftArea = juce::Rectangle<int>(60, 120, 100, 140);
-    leftArea = leftArea.withCentre(juce::Point<int>(120, getHeight() / 2 + 20));
+    leftArea = leftArea.withCentre(juce::Point<int>(120, bounds.getCentreY()));
     fieldLabel.setBounds(leftArea.removeFromTop(20));
     fieldAmountKnob.setBounds(leftArea.removeFromTop(100));
 
     // Right area for MODE selector
     auto rightArea = juce::Rectangle<int>(getWidth() - 180, 120, 120, 100);
-    rightArea = rightArea.withCentre(juce::Point<int>(getWidth() - 120, getHeight() / 2 + 20));
+    rightArea = rightArea.withCentre(juce::Point<int>(getWidth() - 120, bounds.getCentreY()));
     modeLabel.setBounds(rightArea.removeFromTop(20));
     modeSelector.setBounds(rightArea.removeFromTop(30).reduced(10, 0));
 
-    // Bottom area for stereo visualization
-    auto vizArea = getLocalBounds().removeFromBottom(80).reduced(40, 10);
+    // Bottom of the control area for stereo visualization
+    auto vizArea = bounds.removeFromBottom(80).reduced(40, 10);
     stereoViz.setBounds(vizArea);
 }
 
-void FieldAudioProcessorEditor::timerCallback()
+void FieldAudioProcessorEditor::onVBlank(double timestampSec)
 {
-    // Update stereo visualization with current audio levels
-    auto levels = audioProcessor.getCurrentLevels();
-    stereoViz.update(levels.left, levels.right);
+    // The display may refresh at 60-144 Hz; the meter ballistics assume 30 Hz
+    // ticks. The 10% slack keeps frame jitter on a 60 Hz display from skipping one.
+    if (timestampSec - lastMeterTick < 0.9 / meterRateHz) {
+        return;
+    }
+
+    lastMeterTick = timestampSec;
+
+    // Combine every block published since the last tick into one RMS level
+    double sumSquaresLeft = 0.0, sumSquaresRight = 0.0;
+    int totalSamples = 0;
+
+    audioProcessor.getTelemetry().drain([&](const TelemetryFrame& frame) {
+        sumSquaresLeft += static_cast<double>(frame.rmsLeft) * frame.rmsLeft * frame.numSamples;
+        sumSquaresRight += static_cast<double>(frame.rmsRight) * frame.rmsRight * frame.numSamples;
+        totalSamples += frame.numSamples;
+    });
+
+    // Without new blocks (large host buffers, stopped transport) keep the last level
+    if (totalSamples > 0) {
+        displayedLeft = static_cast<float>(std::sqrt(sumSquaresLeft / totalSamples));
+        displayedRight = static_cast<float>(std::sqrt(sumSquaresRight / totalSamples));
+    }
+
+    // Update stereo visualization; it repaints only what moved
+    stereoViz.update(displayedLeft, displayedRight);
+
+    // Plot the output samples that arrived since the last tick
+    phaseScope.update(audioProcessor.getScope());
 }
@@ -6,11 +6,11 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "PhaseScope.h"
 #include "PluginProcessor.h"
 #include "StereoVisualization.h"
 
-class FieldAudioProcessorEditor : public juce::AudioProcessorEditor,
-                                   private juce::Timer {
+class FieldAudioProcessorEditor : public juce::AudioProcessorEditor {
 public:
     explicit FieldAudioProcessorEditor(FieldAudioProcessor&);
     ~FieldAudioProcessorEditor() override = default;
@@ -34,21 +34,38 @@ private:
     juce::Label modeLabel;
     juce::Label titleLabel;
 
-    // Stereo visualization
+    // Stereo visualization, fed from the processor's telemetry
     StereoVisualization stereoViz;
+    float displayedLeft = 0.0f;
+    float displayedRight = 0.0f;
+
+    // Goniometer and correlation meter, fed from the processor's scope FIFO
+    PhaseScope phaseScope;
 
     // Attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> energyAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> fieldAmountAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modeAttachment;
 
+    // Background gradient and version label, at backgroundScale
+    juce::Image backgroundCache;
+    float backgroundScale = 1.0f;
+
+    void renderBackground(float scale);
+
     // Colors
     const juce::Colour bgDark = juce::Colour(0xFF1A1A1A);
     const juce::Colour accentBlue = juce::Colour(0xFF4A90D9);
     const juce::Colour textLight = juce::Colour(0xFFE0E0E0);
 
-    // Timer for visualization updates
-    void timerCallback() override;
+    // Visualization updates follow the display refresh, thinned to meterRateHz
+    static constexpr double meterRateHz = 30.0;
+    double lastMeterTick = 0.0;
+
+    void onVBlank(double timestampSec);
+
+    // Declared last so it is detached before anything its callback touches
+    juce::VBlankAttachment vBlankAttachment { this, [this](double timestampSec) { onVBlank(timestampSec); } };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FieldAudioProcessorEditor)
 };
@@ -15,6 +15,14 @@ FieldAudioProcessor::FieldAudioProcessor()
     modeParam = apvts.getRawParameterValue("mode");
     energyParam = apvts.getRawParameterValue("energy");
     fieldAmountParam = apvts.getRawParameterValue("field_amount");
+
+    // Exciter lookup tables are built on the message thread
+    startTimerHz(20);
+}
+
+FieldAudioProcessor::~FieldAudioProcessor()
+{
+    stopTimer();
 }
 
 //==============================================================================
@@ -55,41 +63,134 @@ juce::AudioProcessorValueTreeState::ParameterLayout FieldAudioProcessor::createP
 //==============================================================================
 void FieldAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Prepare all tap processors
-    for (auto& tap : tapProcessors) {
-        tap.prepare(sampleRate);
+    currentSampleRate = sampleRate;
+
+    // Offline renders get the higher oversampling tier
+    const bool offline = isNonRealtime();
+    const auto oversampling = offline ? offlineOversampling : realtimeOversampling;
+
+    // The tap field projects into every channel of the output layout
+    const auto layout = getChannelLayoutOfBus(false, 0);
+
+    // All of the engine's state is allocated and faulted in here, not in the first callbacks
+    if (isUsingDoublePrecision())
+    {
+        doubleEngine.setLockMemory(lockDspMemory);
+        doubleEngine.setLookaheadLimiter(lookaheadLimiter, limiterLookaheadMs);
+        doubleEngine.prepare(sampleRate, samplesPerBlock, oversampling, offline, layout, fieldRenderer);
+    }
+    else
+    {
+        floatEngine.setLockMemory(lockDspMemory);
+        floatEngine.setLookaheadLimiter(lookaheadLimiter, limiterLookaheadMs);
+        floatEngine.prepare(sampleRate, samplesPerBlock, oversampling, offline, layout, fieldRenderer);
     }
 
-    // Setup smoothing for dry/wet (20ms ramp time)
-    dryWetSmoothed.reset(sampleRate, 0.02);
-    dryWetSmoothed.setCurrentAndTargetValue(0.5f);
+    // Report the oversampling and limiter latency; the engine delays its dry path to match
+    latencySamples = isUsingDoublePrecision() ? doubleEngine.getLatencySamples() : floatEngine.getLatencySamples();
+    setLatencySamples(latencySamples);
 
-    // Initialize with Studio mode
-    updateTapsFromMode(ModePresets::STUDIO);
-    currentModeIndex = 0;
+    // Start directly on the current mode and ENERGY; later changes crossfade and ramp
+    currentModeIndex = static_cast<int>(modeParam->load());
+    updateTapsFromMode(currentModeIndex, false);
+
+    const float profile = ModePresets::getMode(currentModeIndex).harmonicProfile;
+
+    if (isUsingDoublePrecision())
+        doubleEngine.resetExcitation(energyParam->load(), profile);
+    else
+        floatEngine.resetExcitation(energyParam->load(), profile);
+
+    // The first blocks already run on the table; the precision may also have
+    // changed, so the engine now in use gets one even if the values have not
+    updateCurveTable(true);
+
+    silentSamples = 0;
+    sleeping = false;
+
+    loadMeasurer.reset(sampleRate, samplesPerBlock);
+    scope.prepare(sampleRate);
 }
 
 void FieldAudioProcessor::releaseResources()
 {
-    for (auto& tap : tapProcessors) {
-        tap.reset();
-    }
+    floatEngine.reset();
+    doubleEngine.reset();
+
+    silentSamples = 0;
+    sleeping = false;
+}
+
+void FieldAudioProcessor::setOversamplingTiers(ExciterOversampling realtime, ExciterOversampling offline)
+{
+    realtimeOversampling = realtime;
+    offlineOversampling = offline;
+}
+
+void FieldAudioProcessor::setFieldRenderer(FieldRenderer newRenderer)
+{
+    fieldRenderer = newRenderer;
+}
+
+void FieldAudioProcessor::setLockDspMemory(bool shouldLock)
+{
+    lockDspMemory = shouldLock;
+}
+
+void FieldAudioProcessor::setLookaheadLimiter(bool enabled, float lookaheadMs)
+{
+    lookaheadLimiter = enabled;
+    limiterLookaheadMs = lookaheadMs;
+}
+
+double FieldAudioProcessor::getLimiterSettlingSeconds() const
+{
+    return lookaheadLimiter ? LookaheadLimiter<float>::getSettlingSeconds(currentSampleRate, limiterLookaheadMs) : 0.0;
+}
+
+double FieldAudioProcessor::getTailLengthSeconds() const
+{
+    // Longest tap delay plus its filter ring-out, plus the oversampling and limiter latency
+    const auto& mode = ModePresets::getMode(static_cast<int>(modeParam->load()));
+    return ModePresets::getTailMs(mode) / 1000.0 + latencySamples / currentSampleRate;
 }
 
 bool FieldAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    // Stereo in, stereo out
-    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo()
-        && layouts.getMainInputChannelSet() == juce::AudioChannelSet::stereo();
+    // Same layout in and out: stereo, or a surround/immersive bed
+    const auto output = layouts.getMainOutputChannelSet();
+
+    if (layouts.getMainInputChannelSet() != output)
+        return false;
+
+    return output == juce::AudioChannelSet::stereo()
+        || output == juce::AudioChannelSet::create5point1()
+        || output == juce::AudioChannelSet::create7point1()
+        || output == juce::AudioChannelSet::create7point1point4();
 }
 
 //==============================================================================
 void FieldAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processBlockWithEngine(buffer, floatEngine);
+}
+
+void FieldAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    processBlockWithEngine(buffer, doubleEngine);
+}
+
+template <typename SampleType>
+void FieldAudioProcessor::processBlockWithEngine(juce::AudioBuffer<SampleType>& buffer, FieldEngine<SampleType>& engine)
 {
     juce::ScopedNoDenormals noDenormals;
 
+    const auto startTicks = juce::Time::getHighResolutionTicks();
     const int numSamples = buffer.getNumSamples();
 
+    TelemetryFrame frame;
+    frame.numSamples = numSamples;
+
     // Get parameter values
     int modeIndex = static_cast<int>(modeParam->load());
     float energy = energyParam->load();
@@ -98,97 +199,114 @@ void FieldAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     // Check for mode change
     if (modeIndex != currentModeIndex) {
         currentModeIndex = modeIndex;
-        const auto& mode = ModePresets::getMode(modeIndex);
-        updateTapsFromMode(mode);
+        updateTapsFromMode(modeIndex, true);
     }
 
     // Get current mode
     const auto& mode = ModePresets::getMode(modeIndex);
 
-    // Update harmonic generator
-    harmonicGen.setEnergy(energy);
-    harmonicGen.setHarmonicProfile(mode.harmonicProfile);
+    // Update harmonic generator: ENERGY ramps across this block, and the
+    // coefficients are only recalculated where it moves
+    engine.setExcitation(energy, mode.harmonicProfile, numSamples);
 
     // Update dry/wet smoothing target
-    dryWetSmoothed.setTargetValue(fieldAmount);
+    engine.setFieldAmount(fieldAmount);
 
     // Mode compensation trim
-    float compensationGain = juce::Decibels::decibelsToGain(mode.compensationTrim);
-
-    // Store dry signal
-    auto dryL = buffer.getSample(0, 0);
-    auto dryR = buffer.getSample(1, 0);
-
-    // Process each sample
-    for (int sample = 0; sample < numSamples; ++sample) {
-        float L = buffer.getSample(0, sample);
-        float R = buffer.getSample(1, sample);
+    auto compensationGain = juce::Decibels::decibelsToGain(static_cast<SampleType>(mode.compensationTrim));
+
+    // Silence detection: asleep, the output is silent without running any DSP
+    const bool inputSilent = buffer.getMagnitude(0, numSamples) < silenceThreshold;
+
+    if (! inputSilent) {
+        silentSamples = 0;
+        sleeping = false;
+    } else if (sleeping) {
+        buffer.clear();
+        engine.skip(numSamples);
+        scope.write(buffer.getReadPointer(0), buffer.getReadPointer(1), numSamples);
+        frame.sleeping = true;
+        publishTelemetry(frame, startTicks);
+        return;
+    }
 
-        // Store dry for later mix
-        float drySignalL = L;
-        float drySignalR = R;
+    jassert(buffer.getNumChannels() >= engine.getNumChannels());
+    engine.process(buffer.getArrayOfWritePointers(), numSamples, compensationGain);
 
-        // 1. Mono sum
-        float mono = (L + R) * 0.5f;
+    // Go to sleep once the tail has played out and the output has decayed
+    if (inputSilent) {
+        silentSamples = juce::jmin(silentSamples + numSamples, tailSamples);
+        sleeping = silentSamples >= tailSamples && buffer.getMagnitude(0, numSamples) < silenceThreshold;
+    }
 
-        // 2. Pre-attenuation (-6 dB)
-        mono *= 0.5f;
+    // Output levels, measured by the engine's output stage
+    const auto& meterLeft = engine.getMeter(0);
+    const auto& meterRight = engine.getMeter(1);
+    frame.peakLeft = static_cast<float>(meterLeft.getPeak());
+    frame.peakRight = static_cast<float>(meterRight.getPeak());
+    frame.rmsLeft = static_cast<float>(meterLeft.getRMS());
+    frame.rmsRight = static_cast<float>(meterRight.getRMS());
+    frame.truePeakLeft = static_cast<float>(meterLeft.getTruePeak());
+    frame.truePeakRight = static_cast<float>(meterRight.getTruePeak());
+    frame.drive = engine.getDrive();
+    frame.ceilingReductionDb = engine.getCeilingReductionDb();
+
+    // Front L/R for the scope; every supported layout starts with them
+    scope.write(buffer.getReadPointer(0), buffer.getReadPointer(1), numSamples);
+
+    publishTelemetry(frame, startTicks);
+}
 
-        // 3. Harmonic generator
-        float excited = harmonicGen.processSample(mono);
+void FieldAudioProcessor::publishTelemetry(TelemetryFrame& frame, juce::int64 startTicks)
+{
+    const double processMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    loadMeasurer.registerRenderTime(processMs, frame.numSamples);
 
-        // 4. Soft ceiling limiter
-        excited = softCeiling.processSample(excited);
+    frame.processMs = static_cast<float>(processMs);
+    frame.load = static_cast<float>(loadMeasurer.getLoadAsProportion());
+    frame.xruns = loadMeasurer.getXRunCount();
 
-        // 5. 6-tap early field
-        float wetL = 0.0f;
-        float wetR = 0.0f;
+    telemetry.push(frame);
+}
 
-        for (auto& tap : tapProcessors) {
-            auto stereo = tap.process(excited);
-            wetL += stereo.left;
-            wetR += stereo.right;
-        }
+//==============================================================================
+void FieldAudioProcessor::timerCallback()
+{
+    updateCurveTable(false);
+}
 
-        // 6. Mode compensation trim
-        wetL *= compensationGain;
-        wetR *= compensationGain;
+void FieldAudioProcessor::updateCurveTable(bool force)
+{
+    const std::lock_guard<std::mutex> lock(tableMutex);
 
-        // 7. Dry/wet mix (smoothed)
-        float wetAmount = dryWetSmoothed.getNextValue();
-        float dryAmount = 1.0f - wetAmount;
+    const float energy = energyParam->load();
+    const float profile = ModePresets::getMode(static_cast<int>(modeParam->load())).harmonicProfile;
 
-        buffer.setSample(0, sample, drySignalL * dryAmount + wetL * wetAmount);
-        buffer.setSample(1, sample, drySignalR * dryAmount + wetR * wetAmount);
-    }
+    if (! force && juce::exactlyEqual(energy, tableEnergy) && juce::exactlyEqual(profile, tableProfile))
+        return;
 
-    // Calculate RMS levels for visualization
-    float sumL = 0.0f, sumR = 0.0f;
-    for (int sample = 0; sample < numSamples; ++sample) {
-        float L = buffer.getSample(0, sample);
-        float R = buffer.getSample(1, sample);
-        sumL += L * L;
-        sumR += R * R;
-    }
+    // Only the engine that processBlock() runs reads a table
+    if (isUsingDoublePrecision())
+        doubleEngine.buildCurveTable(energy, profile);
+    else
+        floatEngine.buildCurveTable(energy, profile);
 
-    AudioLevels levels;
-    levels.left = std::sqrt(sumL / numSamples);
-    levels.right = std::sqrt(sumR / numSamples);
-    currentLevels.store(levels);
+    tableEnergy = energy;
+    tableProfile = profile;
 }
 
 //==============================================================================
-void FieldAudioProcessor::updateTapsFromMode(const ModePresets::ModeConfig& mode)
-{
-    for (int i = 0; i < 6; ++i) {
-        const auto& tapConfig = mode.taps[i];
-        tapProcessors[i].setParameters(
-            tapConfig.delayMs,
-            tapConfig.pan,
-            tapConfig.lpCutoff,
-            tapConfig.gainDb
-        );
-    }
+void FieldAudioProcessor::updateTapsFromMode(int modeIndex, bool shouldCrossfade)
+{
+    // Both modes' tap fields are prepared up front; this only selects one
+    if (isUsingDoublePrecision())
+        doubleEngine.setMode(modeIndex, shouldCrossfade);
+    else
+        floatEngine.setMode(modeIndex, shouldCrossfade);
+
+    // Silence must last this long before sleeping
+    const auto& mode = ModePresets::getMode(modeIndex);
+    tailSamples = static_cast<int>(std::ceil(ModePresets::getTailMs(mode) * currentSampleRate / 1000.0)) + latencySamples;
 }
 
 //==============================================================================
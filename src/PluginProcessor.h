@@ -6,15 +6,17 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
-#include "TapProcessor.h"
-#include "HarmonicGenerator.h"
-#include "SoftCeiling.h"
+#include "FieldEngine.h"
 #include "ModePresets.h"
+#include "ScopeFifo.h"
+#include "Telemetry.h"
+#include <mutex>
 
-class FieldAudioProcessor : public juce::AudioProcessor {
+class FieldAudioProcessor : public juce::AudioProcessor,
+                            private juce::Timer {
 public:
     FieldAudioProcessor();
-    ~FieldAudioProcessor() override = default;
+    ~FieldAudioProcessor() override;
 
     //==============================================================================
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
@@ -23,6 +25,8 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -34,7 +38,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.1; }
+    double getTailLengthSeconds() const override;
 
     //==============================================================================
     int getNumPrograms() override { return 1; }
@@ -51,43 +55,105 @@ public:
     // Public access to APVTS for UI
     juce::AudioProcessorValueTreeState apvts;
 
-    // Audio levels for visualization
-    struct AudioLevels {
-        float left = 0.0f;
-        float right = 0.0f;
-    };
-
-    AudioLevels getCurrentLevels() const {
-        return currentLevels.load();
-    }
+    // Per-block levels, exciter activity and DSP load, written by
+    // processBlock(). Drain from one thread only (the editor, or a logger).
+    TelemetryRing& getTelemetry() { return telemetry; }
+
+    // Decimated L/R output for the goniometer and correlation meter.
+    // Drain from one thread only.
+    ScopeFifo& getScope() { return scope; }
+
+    // Oversampling of the harmonic stage for live playback and for offline
+    // renders (isNonRealtime()). Takes effect at the next prepareToPlay().
+    void setOversamplingTiers(ExciterOversampling realtime, ExciterOversampling offline);
+
+    // Tap loop or FFT convolution for the tap field; both sound the same, so
+    // this picks whichever is cheaper on the machine. The convolver's FFT is
+    // single precision (juce::dsp::FFT is float-only), so with 64-bit
+    // processing the field is only float-accurate; use the taps where the
+    // double path's full precision matters. Takes effect at the next
+    // prepareToPlay().
+    void setFieldRenderer(FieldRenderer newRenderer);
+
+    // Lock the prepared engine's DSP state into RAM so it cannot be paged out
+    // between callbacks (Linux only, within RLIMIT_MEMLOCK). Takes effect at
+    // the next prepareToPlay().
+    void setLockDspMemory(bool shouldLock);
+
+    // Replace the soft ceiling with a true-peak lookahead limiter looking
+    // lookaheadMs ahead (0.5-5 ms), for loud sound-system material. The
+    // lookahead is added to the reported latency. Takes effect at the next
+    // prepareToPlay().
+    void setLookaheadLimiter(bool enabled, float lookaheadMs = LookaheadLimiter<float>::defaultLookaheadMs);
+
+    // How long the limiter's gain takes to recover fully from a reduction
+    // (about 0.6 s) at the prepared sample rate, or 0 when it is off. A render started mid-file needs
+    // this much pre-roll on top of the tail to match one from the start.
+    double getLimiterSettlingSeconds() const;
 
 private:
     //==============================================================================
-    // DSP Components
-    std::array<TapProcessor, 6> tapProcessors;  // Fixed 6 taps
-    HarmonicGenerator harmonicGen;
-    SoftCeiling softCeiling;
+    // DSP chain at each precision; only the one matching the host's
+    // processing precision is prepared
+    FieldEngine<float> floatEngine;
+    FieldEngine<double> doubleEngine;
 
     // Parameter caching (lock-free audio thread access)
     std::atomic<float>* modeParam = nullptr;
     std::atomic<float>* energyParam = nullptr;
     std::atomic<float>* fieldAmountParam = nullptr;
 
-    // Smoothing
-    juce::SmoothedValue<float> dryWetSmoothed;
+    // Quality tiers, chosen in prepareToPlay()
+    ExciterOversampling realtimeOversampling = ExciterOversampling::x2;
+    ExciterOversampling offlineOversampling = ExciterOversampling::x4;
+    FieldRenderer fieldRenderer = FieldRenderer::taps;
+    bool lockDspMemory = false;
+    bool lookaheadLimiter = false;
+    float limiterLookaheadMs = LookaheadLimiter<float>::defaultLookaheadMs;
+
+    // Oversampling and limiter latency of the prepared engine
+    int latencySamples = 0;
 
     // Current mode index (0 = Studio, 1 = Sound System)
     int currentModeIndex = 0;
+    double currentSampleRate = 44100.0;
 
-    // Audio levels for visualization (thread-safe)
-    std::atomic<AudioLevels> currentLevels;
+    // Sleep mode: once the input has been silent for longer than the tail
+    // and the output has decayed, DSP is skipped until signal returns
+    static constexpr float silenceThreshold = 1.0e-6f;     // -120 dBFS
+    int tailSamples = 0;        // Active preset's tail plus latency
+    int silentSamples = 0;      // Consecutive silent input samples, capped at tailSamples
+    bool sleeping = false;
+
+    // Telemetry (lock-free, audio thread → one reader)
+    TelemetryRing telemetry;
+    juce::AudioProcessLoadMeasurer loadMeasurer;
+    ScopeFifo scope;
 
     //==============================================================================
     // Parameter layout
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // Update taps from mode preset
-    void updateTapsFromMode(const ModePresets::ModeConfig& mode);
+    // Shared body of both processBlock() overloads
+    template <typename SampleType>
+    void processBlockWithEngine(juce::AudioBuffer<SampleType>& buffer, FieldEngine<SampleType>& engine);
+
+    // Stamps the block's processing time and load onto frame and pushes it
+    void publishTelemetry(TelemetryFrame& frame, juce::int64 startTicks);
+
+    // Rebuilds the exciter lookup table when ENERGY or the mode profile changes
+    void timerCallback() override;
+
+    // Builds the active engine's table for the current ENERGY and mode profile,
+    // unless it already matches them. prepareToPlay() may run off the message
+    // thread, so builds are serialised.
+    void updateCurveTable(bool force);
+    std::mutex tableMutex;
+    float tableEnergy = -1.0f;
+    float tableProfile = -1.0f;
+
+    // Switch the tap field to a mode preset
+    void updateTapsFromMode(int modeIndex, bool shouldCrossfade);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FieldAudioProcessor)
 };
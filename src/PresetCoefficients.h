@@ -0,0 +1,92 @@
+// PresetCoefficients.h
+// FIELD — Projection Engine
+// Per-tap filter, pan and gain coefficients for the mode presets, generated at
+// compile time for the standard sample rates
+
+#pragma once
+
+#include "ConstexprMath.h"
+#include "ModePresets.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace PresetCoefficients {
+
+// Everything a tap needs besides its delay, in double so the double
+// precision path gets full accuracy; float processing rounds on load
+struct TapCoefficients {
+    double b0, b1, b2, a1, a2;  // Low-pass biquad, normalised (a0 = 1)
+    double panL, panR;          // Constant-power pan gains
+    double gain;                // Linear tap gain
+};
+
+template <size_t NumTaps>
+using FieldCoefficients = std::array<TapCoefficients, NumTaps>;
+
+using ModeCoefficients = FieldCoefficients<ModePresets::defaultNumTaps>;
+
+//==============================================================================
+// Also used at runtime for rates without a table, so both paths agree exactly
+constexpr TapCoefficients makeTapCoefficients(const ModePresets::TapConfig& tap, double sampleRate) {
+    // Low-pass filter, Butterworth Q (as BiquadFilter::calculateCoefficients)
+    const double freq = std::clamp(static_cast<double>(tap.lpCutoff), 20.0, 20000.0);
+    const double q = static_cast<double>(0.707f);
+    const double w0 = 2.0 * ConstexprMath::pi * freq / sampleRate;
+    const double cosW0 = ConstexprMath::cos(w0);
+    const double alpha = ConstexprMath::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    // Constant-power panning: -100..+100 -> 0..pi/2
+    const double pan = std::clamp(static_cast<double>(tap.pan), -100.0, 100.0);
+    const double angle = (pan + 100.0) / 200.0 * ConstexprMath::pi / 2.0;
+
+    return {
+        (1.0 - cosW0) / 2.0 / a0,
+        (1.0 - cosW0) / a0,
+        (1.0 - cosW0) / 2.0 / a0,
+        -2.0 * cosW0 / a0,
+        (1.0 - alpha) / a0,
+        ConstexprMath::cos(angle),
+        ConstexprMath::sin(angle),
+        ConstexprMath::decibelsToGain(tap.gainDb)
+    };
+}
+
+template <size_t NumTaps>
+constexpr FieldCoefficients<NumTaps> makeModeCoefficients(const ModePresets::FieldConfig<NumTaps>& mode, double sampleRate) {
+    FieldCoefficients<NumTaps> coefficients {};
+    for (size_t i = 0; i < coefficients.size(); ++i)
+        coefficients[i] = makeTapCoefficients(mode.taps[i], sampleRate);
+    return coefficients;
+}
+
+//==============================================================================
+inline constexpr std::array<double, 6> tableSampleRates = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+
+// tables[rate][mode], in the order of tableSampleRates and ModePresets::allModes
+inline constexpr auto tables = [] {
+    std::array<std::array<ModeCoefficients, ModePresets::allModes.size()>, tableSampleRates.size()> result {};
+    for (size_t rate = 0; rate < tableSampleRates.size(); ++rate)
+        for (size_t mode = 0; mode < ModePresets::allModes.size(); ++mode)
+            result[rate][mode] = makeModeCoefficients(*ModePresets::allModes[mode], tableSampleRates[rate]);
+    return result;
+}();
+
+// A copy from the tables at the standard rates; computed for any other rate
+// and for the denser fields
+template <size_t NumTaps = ModePresets::defaultNumTaps>
+FieldCoefficients<NumTaps> getModeCoefficients(int modeIndex, double sampleRate) {
+    const auto mode = static_cast<size_t>(std::clamp(modeIndex, 0, static_cast<int>(ModePresets::allModes.size()) - 1));
+
+    if constexpr (NumTaps == ModePresets::defaultNumTaps) {
+        for (size_t rate = 0; rate < tableSampleRates.size(); ++rate)
+            if (std::abs(sampleRate - tableSampleRates[rate]) < 1.0e-6)
+                return tables[rate][mode];
+    }
+
+    return makeModeCoefficients(ModePresets::getField<NumTaps>(static_cast<int>(mode)), sampleRate);
+}
+
+} // namespace PresetCoefficients
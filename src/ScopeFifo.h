@@ -0,0 +1,83 @@
+// ScopeFifo.h
+// FIELD — Projection Engine
+// Decimated L/R output samples, handed lock-free from the audio thread to the scope display
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <cmath>
+
+// One output sample pair
+struct ScopePoint {
+    float left = 0.0f;
+    float right = 0.0f;
+};
+
+/**
+ * Single-producer, single-consumer FIFO of decimated output samples for the
+ * goniometer and correlation meter.
+ *
+ * The audio thread keeps every decimation-th sample pair, so its cost is a
+ * fixed numSamples / decimation copies per block. If the reader is slow or
+ * gone the excess points are dropped, never waited for; the display rate
+ * has no effect on the audio thread.
+ */
+class ScopeFifo {
+public:
+    static constexpr int capacity = 4096;                 // About 1/3 s of points
+    static constexpr double pointsPerSecond = 12000.0;    // Nominal, before rounding the decimation
+
+    ScopeFifo() = default;
+
+    void prepare(double sampleRate) {
+        decimation = juce::jmax(1, static_cast<int>(std::lround(sampleRate / pointsPerSecond)));
+        nextSample = 0;
+    }
+
+    // Audio thread only
+    template <typename SampleType>
+    void write(const SampleType* left, const SampleType* right, int numSamples) {
+        // Keep the decimation phase running across blocks
+        const int first = nextSample;
+        const int numPoints = first < numSamples ? (numSamples - first + decimation - 1) / decimation : 0;
+        nextSample = first + numPoints * decimation - numSamples;
+
+        const int numToWrite = juce::jmin(numPoints, fifo.getFreeSpace());
+
+        if (numToWrite <= 0) {
+            return;
+        }
+
+        int sample = first;
+
+        fifo.write(numToWrite).forEach([&](int index) {
+            points[static_cast<size_t>(index)] = { static_cast<float>(left[sample]), static_cast<float>(right[sample]) };
+            sample += decimation;
+        });
+    }
+
+    // Reader thread only: passes every pending point to callback, oldest
+    // first, and returns how many there were
+    template <typename Callback>
+    int drain(Callback&& callback) {
+        const int numReady = fifo.getNumReady();
+
+        fifo.read(numReady).forEach([this, &callback](int index) {
+            callback(static_cast<const ScopePoint&>(points[static_cast<size_t>(index)]));
+        });
+
+        return numReady;
+    }
+
+private:
+    // AbstractFifo keeps one slot free to tell full from empty
+    juce::AbstractFifo fifo { capacity + 1 };
+    std::array<ScopePoint, capacity + 1> points {};
+
+    int decimation = 4;
+    int nextSample = 0;     // Offset of the next kept sample from the start of the next block
+
+    JUCE_DECLARE_NON_COPYABLE(ScopeFifo)
+};
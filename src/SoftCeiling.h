@@ -4,38 +4,113 @@
 
 #pragma once
 
+#include <juce_dsp/juce_dsp.h>
 #include <cmath>
+#include <cstring>
 
+template <typename SampleType>
 class SoftCeiling {
 public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
     SoftCeiling() = default;
 
     // Process single sample
-    float processSample(float input) {
-        float absInput = std::abs(input);
+    SampleType processSample(SampleType input) {
+        SampleType absInput = std::abs(input);
 
         if (absInput < threshold) {
             // Below threshold: pass through unchanged
             return input;
         } else if (absInput < kneeEnd) {
             // In soft knee region: gentle compression
-            float overshoot = absInput - threshold;
-            float kneeFactor = overshoot / kneeWidth;
-            float gainReduction = 1.0f - (kneeFactor * kneeFactor * 0.5f);
+            SampleType overshoot = absInput - threshold;
+            SampleType kneeFactor = overshoot / kneeWidth;
+            SampleType gainReduction = SampleType(1) - (kneeFactor * kneeFactor * SampleType(0.5));
 
             return input * gainReduction;
         } else {
             // Above knee: hard limit with soft transition
-            float sign = (input >= 0.0f) ? 1.0f : -1.0f;
-            return sign * (threshold + (kneeWidth * 0.5f));
+            SampleType sign = (input >= SampleType(0)) ? SampleType(1) : SampleType(-1);
+            return sign * (threshold + (kneeWidth * SampleType(0.5)));
         }
     }
 
+    // processSample() across a register, branch-free: every region is
+    // evaluated and a mask picks one per lane. Below the threshold the knee's
+    // gain is exactly 1, so the knee covers that region too.
+    static Vec processRegister(Vec input) {
+        const Vec absInput = Vec::abs(input);
+        const Vec overshoot = Vec::max(absInput - threshold, Vec::expand(SampleType(0)));
+        const Vec kneeFactor = overshoot * inverseKneeWidth;
+        const Vec knee = input * (Vec::expand(SampleType(1)) - kneeFactor * kneeFactor * SampleType(0.5));
+
+        const auto negative = Vec::lessThan(input, Vec::expand(SampleType(0)));
+        const Vec limit = (Vec::expand(-limitLevel) & negative) + (Vec::expand(limitLevel) & ~negative);
+
+        const auto inKnee = Vec::lessThan(absInput, Vec::expand(kneeEnd));
+        return (knee & inKnee) + (limit & ~inKnee);
+    }
+
+    // Limit a block in place, a register at a time. Returns the lowest gain
+    // applied: the gain only falls as the level rises, so the output peak
+    // over the input peak.
+    static SampleType processBlock(SampleType* samples, int numSamples) {
+        auto inputPeak = Vec::expand(SampleType(0));
+        auto outputPeak = inputPeak;
+        int i = 0;
+
+        for (; i + lanes <= numSamples; i += lanes) {
+            Vec v;
+            std::memcpy(&v, samples + i, sizeof(Vec));
+            inputPeak = Vec::max(inputPeak, Vec::abs(v));
+
+            v = processRegister(v);
+            outputPeak = Vec::max(outputPeak, Vec::abs(v));
+            std::memcpy(samples + i, &v, sizeof(Vec));
+        }
+
+        // The remainder through a zero-padded register, so every sample sees
+        // the same arithmetic
+        if (i < numSamples) {
+            const auto remaining = static_cast<size_t>(numSamples - i) * sizeof(SampleType);
+            auto v = Vec::expand(SampleType(0));
+            std::memcpy(&v, samples + i, remaining);
+            inputPeak = Vec::max(inputPeak, Vec::abs(v));
+
+            v = processRegister(v);
+            outputPeak = Vec::max(outputPeak, Vec::abs(v));
+            std::memcpy(samples + i, &v, remaining);
+        }
+
+        return gainBetween(inputPeak, outputPeak);
+    }
+
+    // Lowest gain between two registers of per-lane peaks (1 when silent)
+    static SampleType gainBetween(Vec inputPeak, Vec outputPeak) {
+        SampleType input = SampleType(0);
+        SampleType output = SampleType(0);
+
+        for (size_t lane = 0; lane < Vec::size(); ++lane) {
+            input = juce::jmax(input, inputPeak.get(lane));
+            output = juce::jmax(output, outputPeak.get(lane));
+        }
+
+        return input > SampleType(0) ? output / input : SampleType(1);
+    }
+
 private:
+    static constexpr int lanes = static_cast<int>(Vec::size());
+
     // Threshold: -0.5 dBFS = 0.891 linear
-    static constexpr float threshold = 0.891f;
+    static constexpr SampleType threshold = SampleType(0.891);
 
     // Soft knee width: 3 dB range for smooth transition
-    static constexpr float kneeWidth = 0.15f;
-    static constexpr float kneeEnd = threshold + kneeWidth;
+    static constexpr SampleType kneeWidth = SampleType(0.15);
+    static constexpr SampleType kneeEnd = threshold + kneeWidth;
+
+    // The register form multiplies where processSample() divides, a rounding
+    // step apart inside the knee
+    static constexpr SampleType inverseKneeWidth = SampleType(1) / kneeWidth;
+    static constexpr SampleType limitLevel = threshold + (kneeWidth * SampleType(0.5));
 };
@@ -6,50 +6,66 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
-class StereoVisualization : public juce::Component,
-                             private juce::Timer {
+/**
+ * Stereo width bloom plus L/R meters.
+ *
+ * The background, border, centre line and labels never change, so they are
+ * drawn once per size and display scale into an image. There is no timer:
+ * the owner calls update() once per meter tick, and only the parts whose
+ * on-screen position moved by at least repaintThreshold pixels since the
+ * last paint are repainted.
+ */
+class StereoVisualization : public juce::Component {
 public:
     StereoVisualization() {
-        // Start update timer (30 Hz for smooth animation)
-        startTimerHz(30);
-    }
-
-    ~StereoVisualization() override {
-        stopTimer();
+        // The bloom halves, centred on the origin; paint() only translates them
+        leftArc.addCentredArc(0.0f, 0.0f, arcRadius, arcRadius, 0.0f, 0.0f, juce::MathConstants<float>::pi, true);
+        rightArc.addCentredArc(0.0f, 0.0f, arcRadius, arcRadius, 0.0f,
+                               juce::MathConstants<float>::pi, juce::MathConstants<float>::twoPi, true);
     }
 
     void paint(juce::Graphics& g) override {
-        auto bounds = getLocalBounds().toFloat();
+        // Static layers, rebuilt only when the size or display scale changes
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
 
-        // Background
-        g.setColour(juce::Colour(0xFF0A0A0A));
-        g.fillRoundedRectangle(bounds, 8.0f);
+        if (backgroundCache.isNull() || ! juce::approximatelyEqual(scale, cacheScale)) {
+            renderBackground(scale);
+        }
 
-        // Border
-        g.setColour(accentBlue.withAlpha(0.3f));
-        g.drawRoundedRectangle(bounds.reduced(1.0f), 8.0f, 1.5f);
+        g.drawImage(backgroundCache, getLocalBounds().toFloat());
 
-        // Center line
-        float centerX = bounds.getCentreX();
-        g.setColour(juce::Colour(0xFF333333));
-        g.drawLine(centerX, bounds.getY() + 10, centerX, bounds.getBottom() - 10, 1.0f);
-
-        // L/R Labels
-        g.setColour(textLight.withAlpha(0.6f));
-        g.setFont(juce::Font(10.0f, juce::Font::bold));
-        g.drawText("L", bounds.getX() + 10, bounds.getCentreY() - 5, 20, 10, juce::Justification::left);
-        g.drawText("R", bounds.getRight() - 30, bounds.getCentreY() - 5, 20, 10, juce::Justification::right);
+        const auto state = getDisplayState();
 
         // Stereo width indicator
-        drawStereoWidth(g, bounds);
+        drawStereoWidth(g, state);
 
         // Peak meters
-        drawPeakMeters(g, bounds);
+        drawPeakMeters(g, state);
+
+        // Remember what reached the screen; a partial repaint only refreshes its own strips
+        const auto clip = g.getClipBounds();
+
+        if (clip.intersects(getArcBand())) {
+            painted.arcOffset = state.arcOffset;
+        }
+
+        if (clip.intersects(getLeftMeterRow())) {
+            painted.leftWidth = state.leftWidth;
+            painted.leftPeakX = state.leftPeakX;
+        }
+
+        if (clip.intersects(getRightMeterRow())) {
+            painted.rightWidth = state.rightWidth;
+            painted.rightPeakX = state.rightPeakX;
+        }
     }
 
-    void resized() override {}
+    void resized() override {
+        backgroundCache = {};
+        painted = {};
+    }
 
-    // Update audio levels
+    // Update audio levels, once per meter tick
     void update(float leftLevel, float rightLevel) {
         // RMS smoothing
         const float smoothing = 0.3f;
@@ -73,6 +89,8 @@ public:
         float sum = smoothedLeft + smoothedRight;
         float diff = std::abs(smoothedLeft - smoothedRight);
         stereoWidth = (sum > 0.001f) ? (diff / sum) : 0.0f;
+
+        repaintChangedRegions();
     }
 
 private:
@@ -83,99 +101,181 @@ private:
     float peakRight = 0.0f;
     float stereoWidth = 0.0f;
 
+    // Everything that moves, in pixels
+    struct DisplayState {
+        float arcOffset = 0.0f;     // Distance of each bloom half from the centre
+        float leftWidth = 0.0f;
+        float rightWidth = 0.0f;
+        float leftPeakX = -1.0f;    // Peak indicator positions, -1 when hidden
+        float rightPeakX = -1.0f;
+    };
+
+    DisplayState painted;           // What is on screen now, per strip
+
+    // Static layers at cacheScale
+    juce::Image backgroundCache;
+    float cacheScale = 1.0f;
+
+    juce::Path leftArc, rightArc;
+
     // Constants
     const float peakDecay = 0.95f;
     const juce::Colour accentBlue = juce::Colour(0xFF4A90D9);
     const juce::Colour textLight = juce::Colour(0xFFE0E0E0);
 
-    void timerCallback() override {
-        repaint();
+    static constexpr float arcRadius = 15.0f;
+    static constexpr float meterHeight = 4.0f;
+    static constexpr float repaintThreshold = 0.5f;     // Pixels
+
+    juce::Rectangle<float> getWidthArea() const {
+        return getLocalBounds().toFloat().reduced(20, 15);
     }
 
-    void drawStereoWidth(juce::Graphics& g, juce::Rectangle<float> bounds) {
-        auto widthArea = bounds.reduced(20, 15);
-        float centerX = widthArea.getCentreX();
-        float y = widthArea.getCentreY();
+    juce::Rectangle<float> getMeterArea() const {
+        auto bounds = getLocalBounds().toFloat();
+        return bounds.reduced(15, bounds.getHeight() * 0.3f);
+    }
 
-        // Stereo width arc
-        float arcWidth = widthArea.getWidth() * 0.7f;
-        float widthAmount = stereoWidth * 0.5f;  // 0 to 0.5
-
-        // Draw stereo spread
-        juce::Path leftArc;
-        leftArc.addCentredArc(
-            centerX - arcWidth * widthAmount, y,
-            15.0f, 15.0f,
-            0.0f, 0.0f, juce::MathConstants<float>::pi,
-            true
-        );
+    DisplayState getDisplayState() const {
+        const auto meterArea = getMeterArea();
+        const float halfWidth = meterArea.getWidth() * 0.5f;
 
-        juce::Path rightArc;
-        rightArc.addCentredArc(
-            centerX + arcWidth * widthAmount, y,
-            15.0f, 15.0f,
-            0.0f, juce::MathConstants<float>::pi, juce::MathConstants<float>::twoPi,
-            true
-        );
+        DisplayState state;
+        state.arcOffset = getWidthArea().getWidth() * 0.7f * stereoWidth * 0.5f;
+        state.leftWidth = halfWidth * smoothedLeft;
+        state.rightWidth = halfWidth * smoothedRight;
+        state.leftPeakX = peakLeft > 0.01f ? meterArea.getCentreX() - halfWidth * peakLeft : -1.0f;
+        state.rightPeakX = peakRight > 0.01f ? meterArea.getCentreX() + halfWidth * peakRight : -1.0f;
+        return state;
+    }
+
+    static bool moved(float now, float before) {
+        return std::abs(now - before) >= repaintThreshold;
+    }
+
+    // Strips that hold the moving parts
+    juce::Rectangle<int> getArcBand() const {
+        const float y = getWidthArea().getCentreY();
+        return juce::Rectangle<float>(0.0f, y - arcRadius - 1.0f, static_cast<float>(getWidth()), arcRadius * 2.0f + 2.0f)
+            .getSmallestIntegerContainer();
+    }
+
+    juce::Rectangle<int> getLeftMeterRow() const {
+        return getMeterArea().withHeight(meterHeight).expanded(2.0f).getSmallestIntegerContainer();
+    }
+
+    juce::Rectangle<int> getRightMeterRow() const {
+        const auto meterArea = getMeterArea();
+        return meterArea.withTrimmedTop(meterArea.getHeight() - meterHeight).expanded(2.0f).getSmallestIntegerContainer();
+    }
+
+    // Repaint only the strips whose contents visibly moved since they were last painted
+    void repaintChangedRegions() {
+        const auto next = getDisplayState();
+
+        if (moved(next.arcOffset, painted.arcOffset)) {
+            repaint(getArcBand());
+        }
+
+        if (moved(next.leftWidth, painted.leftWidth) || moved(next.leftPeakX, painted.leftPeakX)) {
+            repaint(getLeftMeterRow());
+        }
+
+        if (moved(next.rightWidth, painted.rightWidth) || moved(next.rightPeakX, painted.rightPeakX)) {
+            repaint(getRightMeterRow());
+        }
+    }
+
+    void renderBackground(float scale) {
+        cacheScale = scale;
+        backgroundCache = juce::Image(juce::Image::ARGB,
+                                      juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                      juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                                      true);
+
+        juce::Graphics g(backgroundCache);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
+        auto bounds = getLocalBounds().toFloat();
+
+        // Background
+        g.setColour(juce::Colour(0xFF0A0A0A));
+        g.fillRoundedRectangle(bounds, 8.0f);
+
+        // Border
+        g.setColour(accentBlue.withAlpha(0.3f));
+        g.drawRoundedRectangle(bounds.reduced(1.0f), 8.0f, 1.5f);
+
+        // Center line
+        float centerX = bounds.getCentreX();
+        g.setColour(juce::Colour(0xFF333333));
+        g.drawLine(centerX, bounds.getY() + 10, centerX, bounds.getBottom() - 10, 1.0f);
+
+        // L/R Labels
+        g.setColour(textLight.withAlpha(0.6f));
+        g.setFont(juce::Font(10.0f, juce::Font::bold));
+        g.drawText("L", bounds.getX() + 10, bounds.getCentreY() - 5, 20, 10, juce::Justification::left);
+        g.drawText("R", bounds.getRight() - 30, bounds.getCentreY() - 5, 20, 10, juce::Justification::right);
+    }
+
+    void drawStereoWidth(juce::Graphics& g, const DisplayState& state) {
+        auto widthArea = getWidthArea();
+        float centerX = widthArea.getCentreX();
+        float y = widthArea.getCentreY();
 
         // Gradient fill for stereo bloom
         juce::ColourGradient gradient(
-            accentBlue.withAlpha(0.8f), centerX - arcWidth * widthAmount, y,
+            accentBlue.withAlpha(0.8f), centerX - state.arcOffset, y,
             accentBlue.withAlpha(0.0f), centerX, y,
             false
         );
         g.setGradientFill(gradient);
-        g.fillPath(leftArc);
+        g.fillPath(leftArc, juce::AffineTransform::translation(centerX - state.arcOffset, y));
 
         juce::ColourGradient gradient2(
-            accentBlue.withAlpha(0.8f), centerX + arcWidth * widthAmount, y,
+            accentBlue.withAlpha(0.8f), centerX + state.arcOffset, y,
             accentBlue.withAlpha(0.0f), centerX, y,
             false
         );
         g.setGradientFill(gradient2);
-        g.fillPath(rightArc);
+        g.fillPath(rightArc, juce::AffineTransform::translation(centerX + state.arcOffset, y));
 
         // Center dot
         g.setColour(accentBlue);
         g.fillEllipse(centerX - 3, y - 3, 6, 6);
     }
 
-    void drawPeakMeters(juce::Graphics& g, juce::Rectangle<float> bounds) {
-        auto meterArea = bounds.reduced(15, bounds.getHeight() * 0.3f);
-        float meterHeight = 4.0f;
+    void drawPeakMeters(juce::Graphics& g, const DisplayState& state) {
+        auto meterArea = getMeterArea();
         float leftY = meterArea.getY();
         float rightY = meterArea.getBottom() - meterHeight;
 
         // Left meter
-        float leftWidth = meterArea.getWidth() * 0.5f * smoothedLeft;
         g.setColour(accentBlue.withAlpha(0.6f));
         g.fillRoundedRectangle(
-            meterArea.getCentreX() - leftWidth, leftY,
-            leftWidth, meterHeight,
+            meterArea.getCentreX() - state.leftWidth, leftY,
+            state.leftWidth, meterHeight,
             2.0f
         );
 
         // Left peak indicator
-        if (peakLeft > 0.01f) {
-            float peakX = meterArea.getCentreX() - (meterArea.getWidth() * 0.5f * peakLeft);
+        if (state.leftPeakX >= 0.0f) {
             g.setColour(accentBlue.brighter(0.5f));
-            g.fillRoundedRectangle(peakX - 1, leftY - 1, 2, meterHeight + 2, 1.0f);
+            g.fillRoundedRectangle(state.leftPeakX - 1, leftY - 1, 2, meterHeight + 2, 1.0f);
         }
 
         // Right meter
-        float rightWidth = meterArea.getWidth() * 0.5f * smoothedRight;
         g.setColour(accentBlue.withAlpha(0.6f));
         g.fillRoundedRectangle(
             meterArea.getCentreX(), rightY,
-            rightWidth, meterHeight,
+            state.rightWidth, meterHeight,
             2.0f
         );
 
         // Right peak indicator
-        if (peakRight > 0.01f) {
-            float peakX = meterArea.getCentreX() + (meterArea.getWidth() * 0.5f * peakRight);
+        if (state.rightPeakX >= 0.0f) {
             g.setColour(accentBlue.brighter(0.5f));
-            g.fillRoundedRectangle(peakX - 1, rightY - 1, 2, meterHeight + 2, 1.0f);
+            g.fillRoundedRectangle(state.rightPeakX - 1, rightY - 1, 2, meterHeight + 2, 1.0f);
         }
     }
 };
@@ -0,0 +1,563 @@
+// TapBank.h
+// FIELD — Projection Engine
+// Structure-of-arrays tap field: filter, gain and pan for all taps run in SIMD lanes
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ChannelProjection.h"
+#include "DelayLine.h"
+#include "DspArena.h"
+#include "ModePresets.h"
+#include "PresetCoefficients.h"
+
+#include <span>
+#include <utility>
+
+/**
+ * All NumTaps taps of the early field, stored lane-wise.
+ * Signal chain per tap: Delay → Filter → Gain → Pan (same as TapProcessor)
+ *
+ * Each tap occupies one lane of a juce::dsp::SIMDRegister, so the biquads,
+ * gain ramps and pan ramps of every tap advance together. Unused lanes in
+ * the last register have zero coefficients and gains.
+ *
+ * The hand-tuned modes have six taps; other tap counts load the denser
+ * fields ModePresets derives from them. The per-sample register loops are
+ * expanded at compile time for each NumTaps, and the lanes are summed as a
+ * pairwise tree, so the fixed per-sample work (history write, horizontal
+ * sums, output stores) is shared by more taps as NumTaps grows.
+ *
+ * Every mode has its own complete tap field, loaded in prepare() from the
+ * compile-time PresetCoefficients tables, and all of them read from one
+ * shared input history. A mode change is an equal-power crossfade from the
+ * old field to the new one; only during the crossfade are two fields
+ * evaluated.
+ *
+ * Stereo output sums the lanes into L and R. On surround and immersive
+ * layouts each tap instead has a gain per output channel (from
+ * ChannelProjection), and the taps are mixed into registers that hold the
+ * output channels side by side, so every channel advances together.
+ *
+ * The history, per-sample frames and crossfade buffers are carved from a
+ * DspArena: the engine's, or one the bank owns when prepared standalone.
+ */
+template <typename SampleType, size_t NumTaps = ModePresets::defaultNumTaps>
+class TapBank {
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int numTaps = static_cast<int>(NumTaps);
+    static constexpr int lanesPerRegister = static_cast<int>(Vec::size());
+    static constexpr int numRegisters = (numTaps + lanesPerRegister - 1) / lanesPerRegister;
+    static constexpr int numLanes = numRegisters * lanesPerRegister;
+    static constexpr int numModes = static_cast<int>(ModePresets::allModes.size());
+    static constexpr int maxChannelRegisters = (ChannelProjection::maxChannels + lanesPerRegister - 1) / lanesPerRegister;
+
+    TapBank() = default;
+
+    // Standalone use: lays the bank out in an arena of its own
+    void prepare(double newSampleRate, int maxBlockSize,
+                 const juce::AudioChannelSet& newLayout = juce::AudioChannelSet::stereo()) {
+        ownArena.build([&](DspArena& arena) {
+            prepare(newSampleRate, maxBlockSize, newLayout, arena);
+        });
+    }
+
+    // Loads every mode's delays, coefficients and gains; switching modes
+    // afterwards does no maths on the audio thread
+    void prepare(double newSampleRate, int maxBlockSize, const juce::AudioChannelSet& newLayout, DspArena& arena) {
+        jassert(newLayout.size() >= 2 && newLayout.size() <= ChannelProjection::maxChannels);
+
+        // Stereo keeps the L/R path; anything wider mixes channel-parallel
+        layout = newLayout;
+        numOutputChannels = layout.size();
+        numChannelRegisters = layout == juce::AudioChannelSet::stereo()
+                                  ? 0
+                                  : (numOutputChannels + lanesPerRegister - 1) / lanesPerRegister;
+
+        // One history shared by every tap, long enough for the longest preset
+        // delay; DelayLine adds the interpolation margin. Laid out in the
+        // order process() walks it.
+        history.prepare(newSampleRate, ModePresets::maxDelayMs, maxBlockSize, arena);
+        frames = arena.allocate<Vec>(static_cast<size_t>(maxBlockSize * numRegisters));
+
+        const auto numFrameRegisters = static_cast<size_t>(maxBlockSize * numChannelRegisters);
+        outputFrames = arena.allocate<Vec>(numFrameRegisters);
+        incomingFrames = arena.allocate<Vec>(numFrameRegisters);
+        incomingL = arena.allocate<SampleType>(static_cast<size_t>(maxBlockSize));
+        incomingR = arena.allocate<SampleType>(static_cast<size_t>(maxBlockSize));
+
+        const auto fadeLength = static_cast<size_t>(juce::jmax(1, juce::roundToInt(newSampleRate * crossfadeTimeSeconds)));
+        fadeOutGains = arena.allocate<SampleType>(fadeLength);
+        fadeInGains = arena.allocate<SampleType>(fadeLength);
+
+        if (arena.isMeasuring()) {
+            return;
+        }
+
+        // Equal-power crossfade: cos/sin over a quarter period, ending fully
+        // on the incoming field
+
+        for (size_t i = 0; i < fadeLength; ++i) {
+            const auto angle = static_cast<SampleType>(i + 1) / static_cast<SampleType>(fadeLength) * juce::MathConstants<SampleType>::halfPi;
+            fadeOutGains[i] = std::cos(angle);
+            fadeInGains[i] = std::sin(angle);
+        }
+
+        // Table copies at the standard rates, computed otherwise
+        for (int mode = 0; mode < numModes; ++mode) {
+            fields[static_cast<size_t>(mode)].prepare(newSampleRate, history,
+                                                      ModePresets::getField<NumTaps>(mode).taps,
+                                                      PresetCoefficients::getModeCoefficients<NumTaps>(mode, newSampleRate),
+                                                      layout);
+        }
+
+        reset();
+    }
+
+    // Clears all history and filter state, and completes any pending mode change
+    void reset() {
+        history.reset();
+
+        for (auto& field : fields) {
+            field.resetFilters();
+        }
+
+        activeField = requestedField;
+        incomingField = -1;
+    }
+
+    // Drops every span into the arena from the last prepare(), for an owner
+    // that has stopped rendering with this bank; prepare() again before use
+    void release() {
+        history = {};
+        frames = outputFrames = incomingFrames = {};
+        fadeOutGains = fadeInGains = incomingL = incomingR = {};
+    }
+
+    // Switch to another mode's tap field. With shouldCrossfade, the switch is
+    // spread over the crossfade time; a switch requested mid-crossfade starts
+    // once the current one completes.
+    void setMode(int modeIndex, bool shouldCrossfade = true) {
+        requestedField = juce::jlimit(0, numModes - 1, modeIndex);
+
+        if (! shouldCrossfade) {
+            if (requestedField != activeField) {
+                fields[static_cast<size_t>(requestedField)].resetFilters();
+            }
+
+            activeField = requestedField;
+            incomingField = -1;
+        } else if (incomingField < 0 && requestedField != activeField) {
+            startCrossfade();
+        }
+    }
+
+    // Change one tap of the current mode's field until the next prepare();
+    // gain and pan ramp to the new values
+    void setTap(int tap, const ModePresets::TapConfig& config) {
+        fields[static_cast<size_t>(requestedField)].setTap(tap, config, history, layout);
+    }
+
+    int getNumOutputChannels() const { return numOutputChannels; }
+
+    // Process a block of mono input into the summed stereo tap field.
+    // numSamples must not exceed the maxBlockSize passed to prepare().
+    void process(const SampleType* monoInput, SampleType* outL, SampleType* outR, int numSamples) {
+        // 1. Write the block once; every field reads its delays from it
+        history.writeBlock(monoInput, numSamples);
+
+        renderField(fields[static_cast<size_t>(activeField)], outL, outR, numSamples);
+
+        if (incomingField < 0) {
+            return;
+        }
+
+        // Crossfade: the incoming field runs alongside until it has taken over
+        SampleType* inL = incomingL.data();
+        SampleType* inR = incomingR.data();
+        renderField(fields[static_cast<size_t>(incomingField)], inL, inR, numSamples);
+
+        const auto fadeLength = static_cast<int>(fadeOutGains.size());
+        const int fadeSamples = juce::jmin(numSamples, fadeLength - fadePosition);
+        const SampleType* fadeOut = fadeOutGains.data() + fadePosition;
+        const SampleType* fadeIn = fadeInGains.data() + fadePosition;
+
+        for (int i = 0; i < fadeSamples; ++i) {
+            outL[i] = outL[i] * fadeOut[i] + inL[i] * fadeIn[i];
+            outR[i] = outR[i] * fadeOut[i] + inR[i] * fadeIn[i];
+        }
+
+        std::copy(inL + fadeSamples, inL + numSamples, outL + fadeSamples);
+        std::copy(inR + fadeSamples, inR + numSamples, outR + fadeSamples);
+
+        advanceCrossfade(fadeSamples);
+    }
+
+    // Process a block of mono input into one output per channel of the
+    // prepared layout. Stereo layouts take the L/R path above.
+    void process(const SampleType* monoInput, SampleType* const* outputs, int numSamples) {
+        if (numChannelRegisters == 0) {
+            process(monoInput, outputs[0], outputs[1], numSamples);
+            return;
+        }
+
+        history.writeBlock(monoInput, numSamples);
+
+        renderFieldChannels(fields[static_cast<size_t>(activeField)], outputFrames.data(), numSamples);
+
+        if (incomingField >= 0) {
+            renderFieldChannels(fields[static_cast<size_t>(incomingField)], incomingFrames.data(), numSamples);
+
+            const auto fadeLength = static_cast<int>(fadeOutGains.size());
+            const int fadeSamples = juce::jmin(numSamples, fadeLength - fadePosition);
+
+            for (int i = 0; i < fadeSamples; ++i) {
+                Vec* out = outputFrames.data() + i * numChannelRegisters;
+                const Vec* in = incomingFrames.data() + i * numChannelRegisters;
+                const auto fadeOut = Vec::expand(fadeOutGains[static_cast<size_t>(fadePosition + i)]);
+                const auto fadeIn = Vec::expand(fadeInGains[static_cast<size_t>(fadePosition + i)]);
+
+                for (int c = 0; c < numChannelRegisters; ++c) {
+                    out[c] = out[c] * fadeOut + in[c] * fadeIn;
+                }
+            }
+
+            std::copy(incomingFrames.begin() + fadeSamples * numChannelRegisters,
+                      incomingFrames.begin() + numSamples * numChannelRegisters,
+                      outputFrames.begin() + fadeSamples * numChannelRegisters);
+
+            advanceCrossfade(fadeSamples);
+        }
+
+        // Split the channel frames out to the host's channel buffers
+        const auto* frameData = reinterpret_cast<const SampleType*>(outputFrames.data());
+        const int frameStride = numChannelRegisters * lanesPerRegister;
+
+        for (int channel = 0; channel < numOutputChannels; ++channel) {
+            SampleType* out = outputs[channel];
+
+            for (int i = 0; i < numSamples; ++i) {
+                out[i] = frameData[i * frameStride + channel];
+            }
+        }
+    }
+
+private:
+    using Lanes = std::array<Vec, numRegisters>;
+
+    static void setLane(Lanes& lanes, int tap, double value) {
+        lanes[static_cast<size_t>(tap / lanesPerRegister)].set(static_cast<size_t>(tap % lanesPerRegister), static_cast<SampleType>(value));
+    }
+
+    // Calls fn with every register index as a compile-time constant, so the
+    // per-sample loops become straight-line code for each NumTaps
+    template <typename Fn>
+    static void forEachRegister(Fn&& fn) {
+        [&]<int... r>(std::integer_sequence<int, r...>) {
+            (fn(std::integral_constant<int, r> {}), ...);
+        }(std::make_integer_sequence<int, numRegisters> {});
+    }
+
+    // Sum of registers [begin, begin + count) as a pairwise tree rather than
+    // one long chain of dependent adds
+    template <int begin = 0, int count = numRegisters>
+    static Vec sumRegisters(const Lanes& v) {
+        if constexpr (count == 1) {
+            return v[static_cast<size_t>(begin)];
+        } else {
+            constexpr int half = (count + 1) / 2;
+            return sumRegisters<begin, half>(v) + sumRegisters<begin + half, count - half>(v);
+        }
+    }
+
+    //==============================================================================
+    // The complete state of one mode's taps
+    struct Field {
+        Field() {
+            for (int i = 0; i < numRegisters; ++i) {
+                b0[i] = b1[i] = b2[i] = a1[i] = a2[i] = Vec::expand(SampleType(0));
+                gain[i] = targetGain[i] = gainStep[i] = Vec::expand(SampleType(0));
+                panL[i] = targetPanL[i] = panLStep[i] = Vec::expand(SampleType(0));
+                panR[i] = targetPanR[i] = panRStep[i] = Vec::expand(SampleType(0));
+                settledGainL[i] = settledGainR[i] = Vec::expand(SampleType(0));
+            }
+
+            channelGain.fill(Vec::expand(SampleType(0)));
+            targetChannelGain.fill(Vec::expand(SampleType(0)));
+            channelGainStep.fill(Vec::expand(SampleType(0)));
+
+            resetFilters();
+        }
+
+        // Load delays and coefficients for the new rate, starting settled
+        void prepare(double newSampleRate, const DelayLine<SampleType>& history,
+                     const std::array<ModePresets::TapConfig, NumTaps>& taps,
+                     const PresetCoefficients::FieldCoefficients<NumTaps>& coefficients,
+                     const juce::AudioChannelSet& layout) {
+            sampleRate = newSampleRate;
+            rampLength = juce::jmax(1, juce::roundToInt(sampleRate * rampTimeSeconds));
+
+            for (int tap = 0; tap < numTaps; ++tap) {
+                const auto& config = taps[static_cast<size_t>(tap)];
+                delays[static_cast<size_t>(tap)] = history.makeTap(config.delayMs);
+                setCoefficients(tap, coefficients[static_cast<size_t>(tap)]);
+                setProjection(tap, ChannelProjection::getTapGains(config.pan, layout), coefficients[static_cast<size_t>(tap)].gain);
+            }
+
+            settleRamps();
+        }
+
+        void resetFilters() {
+            for (int i = 0; i < numRegisters; ++i) {
+                z1[i] = z2[i] = Vec::expand(SampleType(0));
+            }
+        }
+
+        void setTap(int tap, const ModePresets::TapConfig& config, const DelayLine<SampleType>& history,
+                    const juce::AudioChannelSet& layout) {
+            const auto coefficients = PresetCoefficients::makeTapCoefficients(config, sampleRate);
+            delays[static_cast<size_t>(tap)] = history.makeTap(config.delayMs);
+            setCoefficients(tap, coefficients);
+            setProjection(tap, ChannelProjection::getTapGains(config.pan, layout), coefficients.gain);
+            startRamps();
+        }
+
+        // Filter coefficients apply at once; gain and pan become ramp targets
+        void setCoefficients(int tap, const PresetCoefficients::TapCoefficients& c) {
+            setLane(b0, tap, c.b0);
+            setLane(b1, tap, c.b1);
+            setLane(b2, tap, c.b2);
+            setLane(a1, tap, c.a1);
+            setLane(a2, tap, c.a2);
+            setLane(targetPanL, tap, c.panL);
+            setLane(targetPanR, tap, c.panR);
+            setLane(targetGain, tap, c.gain);
+        }
+
+        // Multichannel ramp target: the tap gain folded into each channel's pan gain
+        void setProjection(int tap, const ChannelProjection::ChannelGains& channelGains, double tapGain) {
+            Vec* row = targetChannelGain.data() + tap * maxChannelRegisters;
+
+            for (int channel = 0; channel < ChannelProjection::maxChannels; ++channel) {
+                row[channel / lanesPerRegister].set(static_cast<size_t>(channel % lanesPerRegister),
+                                                    static_cast<SampleType>(channelGains[static_cast<size_t>(channel)] * tapGain));
+            }
+        }
+
+        // 2-4. Filter, gain and pan for all taps at once
+        void process(const Vec* frames, SampleType* outL, SampleType* outR, int numSamples) {
+            // While gain or pan is ramping, they step linearly every sample...
+            const int rampEnd = juce::jmin(numSamples, rampRemaining);
+            int i = 0;
+
+            for (; i < rampEnd; ++i) {
+                const Vec* frame = frames + i * numRegisters;
+                Lanes toL, toR;
+
+                forEachRegister([&](auto r) {
+                    const Vec y = filterSample(r, frame[r]);
+
+                    gain[r] += gainStep[r];
+                    panL[r] += panLStep[r];
+                    panR[r] += panRStep[r];
+
+                    const Vec gained = y * gain[r];
+                    toL[r] = gained * panL[r];
+                    toR[r] = gained * panR[r];
+                });
+
+                outL[i] = sumRegisters(toL).sum();
+                outR[i] = sumRegisters(toR).sum();
+            }
+
+            rampRemaining -= rampEnd;
+
+            if (rampEnd > 0 && rampRemaining == 0) {
+                settleRamps();
+            }
+
+            // ...and once settled, each lane has a constant gain per channel
+            for (; i < numSamples; ++i) {
+                const Vec* frame = frames + i * numRegisters;
+                Lanes toL, toR;
+
+                forEachRegister([&](auto r) {
+                    const Vec y = filterSample(r, frame[r]);
+                    toL[r] = y * settledGainL[r];
+                    toR[r] = y * settledGainR[r];
+                });
+
+                outL[i] = sumRegisters(toL).sum();
+                outR[i] = sumRegisters(toR).sum();
+            }
+        }
+
+        // 2-4. Filter all taps at once, then mix them into the output channels,
+        // which sit side by side in numChannelRegisters registers per sample
+        void processChannels(const Vec* frames, Vec* outFrames, int numChannelRegisters, int numSamples) {
+            const int rampEnd = juce::jmin(numSamples, rampRemaining);
+            Lanes y;
+
+            for (int i = 0; i < numSamples; ++i) {
+                const Vec* frame = frames + i * numRegisters;
+
+                forEachRegister([&](auto r) {
+                    y[r] = filterSample(r, frame[r]);
+                });
+
+                // Gains step linearly while ramping, as on the stereo path
+                if (i < rampEnd) {
+                    for (size_t k = 0; k < channelGain.size(); ++k) {
+                        channelGain[k] += channelGainStep[k];
+                    }
+                }
+
+                const auto* tapOutputs = reinterpret_cast<const SampleType*>(y.data());
+                Vec* out = outFrames + i * numChannelRegisters;
+
+                for (int c = 0; c < numChannelRegisters; ++c) {
+                    out[c] = Vec::expand(SampleType(0));
+                }
+
+                for (int tap = 0; tap < numTaps; ++tap) {
+                    const auto x = Vec::expand(tapOutputs[tap]);
+                    const Vec* row = channelGain.data() + tap * maxChannelRegisters;
+
+                    for (int c = 0; c < numChannelRegisters; ++c) {
+                        out[c] += x * row[c];
+                    }
+                }
+            }
+
+            rampRemaining -= rampEnd;
+
+            if (rampEnd > 0 && rampRemaining == 0) {
+                settleRamps();
+            }
+        }
+
+        // Direct Form II Transposed
+        Vec filterSample(int r, Vec x) {
+            const Vec y = b0[r] * x + z1[r];
+            z1[r] = b1[r] * x - a1[r] * y + z2[r];
+            z2[r] = b2[r] * x - a2[r] * y;
+            return y;
+        }
+
+        // Ramp every lane linearly from where it is now to its target over rampLength samples
+        void startRamps() {
+            const auto scale = Vec::expand(SampleType(1) / static_cast<SampleType>(rampLength));
+
+            for (int r = 0; r < numRegisters; ++r) {
+                gainStep[r] = (targetGain[r] - gain[r]) * scale;
+                panLStep[r] = (targetPanL[r] - panL[r]) * scale;
+                panRStep[r] = (targetPanR[r] - panR[r]) * scale;
+            }
+
+            for (size_t k = 0; k < channelGain.size(); ++k) {
+                channelGainStep[k] = (targetChannelGain[k] - channelGain[k]) * scale;
+            }
+
+            rampRemaining = rampLength;
+        }
+
+        // Snap exactly onto the targets
+        void settleRamps() {
+            gain = targetGain;
+            panL = targetPanL;
+            panR = targetPanR;
+            channelGain = targetChannelGain;
+            rampRemaining = 0;
+
+            for (int r = 0; r < numRegisters; ++r) {
+                settledGainL[r] = gain[r] * panL[r];
+                settledGainR[r] = gain[r] * panR[r];
+            }
+        }
+
+        std::array<typename DelayLine<SampleType>::Tap, numTaps> delays {};      // Read offsets into the shared history
+
+        // Biquad coefficients and state (Direct Form II Transposed)
+        Lanes b0, b1, b2, a1, a2;
+        Lanes z1, z2;
+
+        // Gain and pan, ramped linearly towards their targets
+        Lanes gain, targetGain, gainStep;
+        Lanes panL, targetPanL, panLStep;
+        Lanes panR, targetPanR, panRStep;
+        Lanes settledGainL, settledGainR;   // gain * pan, valid once the ramps have settled
+
+        // Multichannel gain * pan per tap, one row of maxChannelRegisters per tap
+        using ChannelRows = std::array<Vec, numTaps * maxChannelRegisters>;
+        ChannelRows channelGain, targetChannelGain, channelGainStep;
+        int rampLength = 1;
+        int rampRemaining = 0;
+
+        double sampleRate = 44100.0;
+    };
+
+    //==============================================================================
+    // Read every tap's delay from the shared history straight into its lane of
+    // the per-sample frames, then run the field over them
+    void renderField(Field& field, SampleType* outL, SampleType* outR, int numSamples) {
+        readTaps(field, numSamples);
+        field.process(frames.data(), outL, outR, numSamples);
+    }
+
+    void renderFieldChannels(Field& field, Vec* outFrames, int numSamples) {
+        readTaps(field, numSamples);
+        field.processChannels(frames.data(), outFrames, numChannelRegisters, numSamples);
+    }
+
+    void readTaps(const Field& field, int numSamples) {
+        auto* frameData = reinterpret_cast<SampleType*>(frames.data());
+
+        for (int tap = 0; tap < numTaps; ++tap) {
+            history.readBlock(field.delays[static_cast<size_t>(tap)], frameData + tap, numSamples, numLanes);
+        }
+    }
+
+    // The incoming field starts from silent filters; its first samples are
+    // masked by the fade-in
+    void startCrossfade() {
+        incomingField = requestedField;
+        fields[static_cast<size_t>(incomingField)].resetFilters();
+        fadePosition = 0;
+    }
+
+    void advanceCrossfade(int fadeSamples) {
+        fadePosition += fadeSamples;
+
+        if (fadePosition == static_cast<int>(fadeOutGains.size())) {
+            activeField = incomingField;
+            incomingField = -1;
+
+            if (requestedField != activeField) {
+                startCrossfade();
+            }
+        }
+    }
+
+    DspArena ownArena;                                  // Used only when prepared standalone
+    DelayLine<SampleType> history;                      // Shared input history
+    std::span<Vec> frames;                              // numRegisters per sample, one lane per tap
+    std::array<Field, numModes> fields;
+
+    int activeField = 0;
+    int incomingField = -1;         // Field being faded in, -1 when not crossfading
+    int requestedField = 0;         // Latest setMode() request
+    int fadePosition = 0;
+    std::span<SampleType> fadeOutGains, fadeInGains;
+    std::span<SampleType> incomingL, incomingR;
+
+    // Multichannel output, numChannelRegisters per sample (unused for stereo)
+    juce::AudioChannelSet layout = juce::AudioChannelSet::stereo();
+    int numOutputChannels = 2;
+    int numChannelRegisters = 0;
+    std::span<Vec> outputFrames, incomingFrames;
+
+    static constexpr double rampTimeSeconds = 0.02;
+    static constexpr double crossfadeTimeSeconds = 0.03;
+};
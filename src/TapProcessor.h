@@ -12,13 +12,20 @@
  * Signal chain: Delay → Pan → Filter → Gain
  * Processes mono input, outputs stereo (L/R after panning)
  */
+template <typename SampleType>
 class TapProcessor {
 public:
     TapProcessor() = default;
 
-    void prepare(double sampleRate) {
-        delayLine.prepare(sampleRate);
+    void prepare(double sampleRate, int maxBlockSize) {
+        arena.build([&](DspArena& a) {
+            delayLine.prepare(sampleRate, 100.0f, 0, a);
+            delayedBlock = a.allocate<SampleType>(static_cast<size_t>(maxBlockSize));
+        });
+
         filter.prepare(sampleRate);
+        rampLength = juce::jmax(1, juce::roundToInt(sampleRate * rampTimeSeconds));
+        settleRamp();
     }
 
     void reset() {
@@ -47,7 +54,7 @@ public:
 
     void setFilterFrequency(float freqHz) {
         // Always use low-pass filter for FIELD
-        filter.setType(BiquadFilter::Type::LowPass);
+        filter.setType(BiquadFilter<SampleType>::Type::LowPass);
         filter.setFrequency(freqHz);
         filter.setQ(0.707f);
     }
@@ -59,24 +66,23 @@ public:
 
     // Process mono input, returns stereo pair
     struct StereoSample {
-        float left;
-        float right;
+        SampleType left;
+        SampleType right;
     };
 
-    StereoSample process(float monoInput) {
+    StereoSample process(SampleType monoInput) {
         // 1. Delay
-        float delayed = delayLine.process(monoInput);
+        SampleType delayed = delayLine.process(monoInput);
 
         // 2. Filter
-        float filtered = filter.process(delayed);
+        SampleType filtered = filter.process(delayed);
 
-        // 3. Gain (with smoothing)
-        gainLinear += (targetGainLinear - gainLinear) * smoothingCoeff;
-        float gained = filtered * gainLinear;
+        // 3-4. Gain and pan (ramped)
+        if (rampRemaining > 0) {
+            advanceRamp();
+        }
 
-        // 4. Pan (with smoothing)
-        panGainL += (targetPanGainL - panGainL) * smoothingCoeff;
-        panGainR += (targetPanGainR - panGainR) * smoothingCoeff;
+        SampleType gained = filtered * gainLinear;
 
         return {
             gained * panGainL,  // Left
@@ -84,36 +90,103 @@ public:
         };
     }
 
+    // Process a block of mono input, adding the panned tap output to outL/outR.
+    // numSamples must not exceed the maxBlockSize passed to prepare().
+    void processBlock(const SampleType* monoInput, SampleType* outL, SampleType* outR, int numSamples) {
+        // 1. Delay (whole block at once)
+        SampleType* delayed = delayedBlock.data();
+        delayLine.processBlock(monoInput, delayed, numSamples);
+
+        // 2. Filter
+        for (int i = 0; i < numSamples; ++i) {
+            delayed[i] = filter.process(delayed[i]);
+        }
+
+        // 3-4. Gain and pan, stepping while the ramp runs...
+        int i = 0;
+
+        for (; i < numSamples && rampRemaining > 0; ++i) {
+            advanceRamp();
+
+            SampleType gained = delayed[i] * gainLinear;
+            outL[i] += gained * panGainL;
+            outR[i] += gained * panGainR;
+        }
+
+        // ...then constant for the rest of the block
+        if (i < numSamples) {
+            juce::FloatVectorOperations::addWithMultiply(outL + i, delayed + i, gainLinear * panGainL, numSamples - i);
+            juce::FloatVectorOperations::addWithMultiply(outR + i, delayed + i, gainLinear * panGainR, numSamples - i);
+        }
+    }
+
 private:
-    DelayLine delayLine;
-    BiquadFilter filter;
+    DspArena arena;                         // Delay buffer and scratch
+    DelayLine<SampleType> delayLine;
+    BiquadFilter<SampleType> filter;
+    std::span<SampleType> delayedBlock;     // Scratch for processBlock()
 
     // Panning
-    float panValue = 0.0f;       // -100 to +100
-    float panGainL = 0.707f;     // cos(pi/4) - center
-    float panGainR = 0.707f;     // sin(pi/4) - center
-    float targetPanGainL = 0.707f;
-    float targetPanGainR = 0.707f;
+    float panValue = 0.0f;                          // -100 to +100
+    SampleType panGainL = SampleType(0.707);        // cos(pi/4) - center
+    SampleType panGainR = SampleType(0.707);        // sin(pi/4) - center
+    SampleType targetPanGainL = SampleType(0.707);
+    SampleType targetPanGainR = SampleType(0.707);
 
     // Gain
     float gainDb = -12.0f;
-    float gainLinear = 0.25f;
-    float targetGainLinear = 0.25f;
+    SampleType gainLinear = SampleType(0.25);
+    SampleType targetGainLinear = SampleType(0.25);
+
+    // Linear ramps towards the targets, snapping exactly onto them
+    SampleType gainStep = 0;
+    SampleType panStepL = 0;
+    SampleType panStepR = 0;
+    int rampLength = 1;
+    int rampRemaining = 0;
+
+    static constexpr double rampTimeSeconds = 0.02;
+    static constexpr SampleType pi = SampleType(3.14159265358979323846);
+
+    void startRamp() {
+        const SampleType scale = SampleType(1) / static_cast<SampleType>(rampLength);
+        gainStep = (targetGainLinear - gainLinear) * scale;
+        panStepL = (targetPanGainL - panGainL) * scale;
+        panStepR = (targetPanGainR - panGainR) * scale;
+        rampRemaining = rampLength;
+    }
+
+    void advanceRamp() {
+        if (--rampRemaining == 0) {
+            settleRamp();
+            return;
+        }
 
-    static constexpr float smoothingCoeff = 0.001f;
-    static constexpr float pi = 3.14159265359f;
+        gainLinear += gainStep;
+        panGainL += panStepL;
+        panGainR += panStepR;
+    }
+
+    void settleRamp() {
+        gainLinear = targetGainLinear;
+        panGainL = targetPanGainL;
+        panGainR = targetPanGainR;
+        rampRemaining = 0;
+    }
 
     void updatePanGains() {
         // Constant-power panning
         // Pan range: -100 to +100 -> angle: 0 to pi/2
-        float normalizedPan = (panValue + 100.0f) / 200.0f;  // 0 to 1
-        float angle = normalizedPan * pi * 0.5f;             // 0 to pi/2
+        SampleType normalizedPan = static_cast<SampleType>((panValue + 100.0f) / 200.0f);  // 0 to 1
+        SampleType angle = normalizedPan * pi * SampleType(0.5);                            // 0 to pi/2
 
         targetPanGainL = std::cos(angle);
         targetPanGainR = std::sin(angle);
+        startRamp();
     }
 
     void updateGainLinear() {
-        targetGainLinear = juce::Decibels::decibelsToGain(gainDb);
+        targetGainLinear = juce::Decibels::decibelsToGain(static_cast<SampleType>(gainDb));
+        startRamp();
     }
 };
@@ -0,0 +1,79 @@
+// Telemetry.h
+// FIELD — Projection Engine
+// Per-block telemetry frames, handed lock-free from the audio thread to one reader
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+
+// Everything measured for one processBlock() call
+struct TelemetryFrame {
+    float peakLeft = 0.0f;              // Output peak, linear
+    float peakRight = 0.0f;
+    float rmsLeft = 0.0f;               // Output RMS, linear
+    float rmsRight = 0.0f;
+    float truePeakLeft = 0.0f;          // 4x oversampled true peak (ITU-R BS.1770-4), linear
+    float truePeakRight = 0.0f;
+    float drive = 0.0f;                 // Peak level into the harmonic stage, linear
+    float ceilingReductionDb = 0.0f;    // Deepest soft-ceiling gain reduction in the block (<= 0)
+    float processMs = 0.0f;             // Time spent in processBlock()
+    float load = 0.0f;                  // DSP load (time taken / block duration), smoothed over blocks
+    int xruns = 0;                      // Blocks that took longer than their duration since prepareToPlay()
+    int numSamples = 0;
+    bool sleeping = false;              // Silence sleep skipped the DSP
+};
+
+/**
+ * Single-producer, single-consumer ring of TelemetryFrames.
+ *
+ * The audio thread pushes one frame per block and never waits: if the reader
+ * has fallen a whole ring behind, the frame is dropped and counted. One
+ * reader (the editor, or a logger) drains the frames in order.
+ */
+class TelemetryRing {
+public:
+    static constexpr int capacity = 1024;   // About 1/3 s of 16-sample blocks at 48 kHz
+
+    TelemetryRing() = default;
+
+    // Audio thread only
+    void push(const TelemetryFrame& frame) {
+        if (fifo.getFreeSpace() == 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        fifo.write(1).forEach([this, &frame](int index) {
+            frames[static_cast<size_t>(index)] = frame;
+        });
+    }
+
+    // Reader thread only: passes every pending frame to callback, oldest
+    // first, and returns how many there were
+    template <typename Callback>
+    int drain(Callback&& callback) {
+        const int numReady = fifo.getNumReady();
+
+        fifo.read(numReady).forEach([this, &callback](int index) {
+            callback(static_cast<const TelemetryFrame&>(frames[static_cast<size_t>(index)]));
+        });
+
+        return numReady;
+    }
+
+    // Frames lost to a full ring since the last call
+    int takeDroppedCount() {
+        return dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    // AbstractFifo keeps one slot free to tell full from empty
+    juce::AbstractFifo fifo { capacity + 1 };
+    std::array<TelemetryFrame, capacity + 1> frames {};
+    std::atomic<int> dropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(TelemetryRing)
+};
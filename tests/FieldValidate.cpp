@@ -0,0 +1,872 @@
+// FieldValidate.cpp
+// FIELD — Projection Engine
+// Runs each optimised DSP kernel against its frozen scalar reference on
+// randomised signals, sample rates, block sizes and parameter automation, and
+// reports the largest sample error and the null-test depth. Exits non-zero if
+// any kernel drifts past its tolerance.
+
+#include <juce_dsp/juce_dsp.h>
+#include "PluginProcessor.h"
+#include "TapProcessor.h"
+#include "ReferenceKernels.h"
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+//==============================================================================
+struct ValidateOptions {
+    juce::int64 seed = 0x4649454c44;
+    int trials = 6;             // Random configurations per kernel
+    double seconds = 0.5;       // Audio per trial
+    juce::String filter;        // Only run kernels whose name contains this
+    juce::String precision;     // Only run this precision; empty runs both
+};
+
+// Off-table rates exercise the computed coefficient paths
+constexpr double sampleRates[] = { 22050.0, 32000.0, 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+constexpr int maxBlockSizes[] = { 1, 7, 16, 61, 128, 333, 512, 1024, 4096 };
+
+// Error of the optimised output against the reference, over a whole trial
+struct ErrorStats {
+    double maxAbsError = 0.0;
+    double errorEnergy = 0.0;
+    double referenceEnergy = 0.0;
+
+    template <typename SampleType>
+    void add(const SampleType* reference, const SampleType* optimised, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            const auto error = static_cast<double>(optimised[i]) - static_cast<double>(reference[i]);
+            maxAbsError = juce::jmax(maxAbsError, std::abs(error));
+            errorEnergy += error * error;
+            referenceEnergy += static_cast<double>(reference[i]) * static_cast<double>(reference[i]);
+        }
+    }
+
+    void merge(const ErrorStats& other)
+    {
+        maxAbsError = juce::jmax(maxAbsError, other.maxAbsError);
+        errorEnergy += other.errorEnergy;
+        referenceEnergy += other.referenceEnergy;
+    }
+
+    // Residual level relative to the reference; -inf when the outputs are identical
+    double getNullDepthDb() const
+    {
+        if (errorEnergy <= 0.0)
+            return -std::numeric_limits<double>::infinity();
+
+        return 10.0 * std::log10(errorEnergy / juce::jmax(referenceEnergy, std::numeric_limits<double>::min()));
+    }
+};
+
+struct Tolerance {
+    double maxAbsError;
+    double nullDepthDb;
+};
+
+// One randomised run: a sample rate, a largest block and a length of audio
+struct Trial {
+    juce::Random& random;
+    double sampleRate;
+    int maxBlockSize;
+    int numSamples;
+
+    // Host blocks vary in size from call to call, up to the prepared maximum
+    int nextBlockSize(int remaining) { return juce::jmin(remaining, 1 + random.nextInt(maxBlockSize)); }
+
+    bool chance(float probability) { return random.nextFloat() < probability; }
+    float between(float low, float high) { return low + random.nextFloat() * (high - low); }
+};
+
+struct Check {
+    juce::String name;
+    const char* precision;      // "float" or "double"
+    Tolerance tolerance;
+    std::function<ErrorStats(Trial&)> run;
+};
+
+//==============================================================================
+// Segments of sine, noise or both at levels from -60 dBFS to +8 dBFS (into
+// the exciter and ceiling), with stretches of digital silence between them
+template <typename SampleType>
+class TestSignal {
+public:
+    TestSignal(juce::Random& randomToUse, double sampleRateToUse)
+        : random(randomToUse), sampleRate(sampleRateToUse) {}
+
+    void fill(SampleType* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            if (--segmentRemaining <= 0)
+                startSegment();
+
+            const double noise = random.nextDouble() * 2.0 - 1.0;
+            phase = std::fmod(phase + phaseIncrement, juce::MathConstants<double>::twoPi);
+            output[i] = static_cast<SampleType>(level * (sineMix * std::sin(phase) + (1.0 - sineMix) * noise));
+        }
+    }
+
+private:
+    void startSegment()
+    {
+        segmentRemaining = juce::jmax(1, static_cast<int>(sampleRate * (0.001 + random.nextDouble() * 0.2)));
+        level = random.nextFloat() < 0.1f ? 0.0 : juce::Decibels::decibelsToGain(-60.0 + random.nextDouble() * 68.0);
+        sineMix = random.nextDouble();
+        phaseIncrement = juce::MathConstants<double>::twoPi * (20.0 + random.nextDouble() * 0.45 * sampleRate) / sampleRate;
+    }
+
+    juce::Random& random;
+    double sampleRate;
+    int segmentRemaining = 0;
+    double level = 0.0;
+    double sineMix = 0.0;
+    double phase = 0.0;
+    double phaseIncrement = 0.0;
+};
+
+// Any delay up to maxDelayMs, with the cutoff kept below Nyquist
+ModePresets::TapConfig randomTap(Trial& trial, float maxDelayMs)
+{
+    const float maxCutoff = juce::jmin(18000.0f, static_cast<float>(trial.sampleRate * 0.45));
+
+    return { trial.between(0.0f, maxDelayMs), trial.between(-100.0f, 100.0f),
+             trial.between(200.0f, maxCutoff), trial.between(-30.0f, 0.0f) };
+}
+
+//==============================================================================
+template <typename SampleType>
+void addChecks(std::vector<Check>& checks, const char* precision)
+{
+    using Buffer = std::vector<SampleType>;
+    constexpr bool isFloat = std::is_same_v<SampleType, float>;
+
+    // Same arithmetic in the same order: only the compiler's instruction
+    // choices (FMA contraction) may separate them
+    const Tolerance rounding = isFloat ? Tolerance { 1.0e-6, -130.0 } : Tolerance { 1.0e-14, -280.0 };
+
+    checks.push_back({ "DelayLine::processBlock", precision, rounding, [](Trial& trial) {
+        DspArena arena;
+        DelayLine<SampleType> line;
+        Reference::DelayLine<SampleType> reference;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        Buffer input(static_cast<size_t>(trial.maxBlockSize)), output(input.size()), expected(input.size());
+        ErrorStats stats;
+
+        arena.build([&](DspArena& a) { line.prepare(trial.sampleRate, 100.0f, trial.maxBlockSize, a); });
+        reference.prepare(trial.sampleRate, 100.0f);
+
+        for (int done = 0; done < trial.numSamples;) {
+            const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+            if (trial.chance(0.3f)) {
+                const float delayMs = trial.between(0.0f, 100.0f);
+                line.setDelayMs(delayMs);
+                reference.setDelayMs(delayMs);
+            }
+
+            signal.fill(input.data(), numSamples);
+            line.processBlock(input.data(), output.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                expected[static_cast<size_t>(i)] = reference.process(input[static_cast<size_t>(i)]);
+
+            stats.add(expected.data(), output.data(), numSamples);
+            done += numSamples;
+        }
+
+        return stats;
+    } });
+
+    // One history written per block, read back at several delays
+    checks.push_back({ "DelayLine::readBlock", precision, rounding, [](Trial& trial) {
+        constexpr int numTaps = 3;
+        DspArena arena;
+        DelayLine<SampleType> line;
+        std::array<typename DelayLine<SampleType>::Tap, numTaps> taps;
+        std::array<Reference::DelayLine<SampleType>, numTaps> references;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        Buffer input(static_cast<size_t>(trial.maxBlockSize)), output(input.size()), expected(input.size());
+        ErrorStats stats;
+
+        arena.build([&](DspArena& a) { line.prepare(trial.sampleRate, 100.0f, trial.maxBlockSize, a); });
+
+        auto setTapDelay = [&](int tap) {
+            const float delayMs = trial.between(0.0f, 100.0f);
+            taps[static_cast<size_t>(tap)] = line.makeTap(delayMs);
+            references[static_cast<size_t>(tap)].setDelayMs(delayMs);
+        };
+
+        for (int tap = 0; tap < numTaps; ++tap) {
+            references[static_cast<size_t>(tap)].prepare(trial.sampleRate, 100.0f);
+            setTapDelay(tap);
+        }
+
+        for (int done = 0; done < trial.numSamples;) {
+            const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+            if (trial.chance(0.3f))
+                setTapDelay(trial.random.nextInt(numTaps));
+
+            signal.fill(input.data(), numSamples);
+            line.writeBlock(input.data(), numSamples);
+
+            for (int tap = 0; tap < numTaps; ++tap) {
+                line.readBlock(taps[static_cast<size_t>(tap)], output.data(), numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    expected[static_cast<size_t>(i)] = references[static_cast<size_t>(tap)].process(input[static_cast<size_t>(i)]);
+
+                stats.add(expected.data(), output.data(), numSamples);
+            }
+
+            done += numSamples;
+        }
+
+        return stats;
+    } });
+
+    checks.push_back({ "BiquadFilter::process", precision, rounding, [](Trial& trial) {
+        using Type = typename BiquadFilter<SampleType>::Type;
+        using ReferenceType = typename Reference::Biquad<SampleType>::Type;
+
+        BiquadFilter<SampleType> filter;
+        Reference::Biquad<SampleType> reference;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        Buffer input(static_cast<size_t>(trial.maxBlockSize)), output(input.size()), expected(input.size());
+        ErrorStats stats;
+
+        filter.prepare(trial.sampleRate);
+        reference.prepare(trial.sampleRate);
+
+        auto setParameters = [&] {
+            const int type = trial.random.nextInt(3);
+            const float frequency = trial.between(20.0f, juce::jmin(20000.0f, static_cast<float>(trial.sampleRate * 0.45)));
+            const float q = trial.between(0.3f, 4.0f);
+
+            filter.setType(static_cast<Type>(type));
+            filter.setFrequency(frequency);
+            filter.setQ(q);
+            reference.setParameters(static_cast<ReferenceType>(type), frequency, q);
+        };
+
+        setParameters();
+
+        for (int done = 0; done < trial.numSamples;) {
+            const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+            if (trial.chance(0.2f))
+                setParameters();
+
+            signal.fill(input.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i) {
+                output[static_cast<size_t>(i)] = filter.process(input[static_cast<size_t>(i)]);
+                expected[static_cast<size_t>(i)] = reference.process(input[static_cast<size_t>(i)]);
+            }
+
+            stats.add(expected.data(), output.data(), numSamples);
+            done += numSamples;
+        }
+
+        return stats;
+    } });
+
+    checks.push_back({ "TapProcessor::processBlock", precision, rounding, [](Trial& trial) {
+        TapProcessor<SampleType> tap;
+        Reference::Tap<SampleType> reference;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        const auto size = static_cast<size_t>(trial.maxBlockSize);
+        Buffer input(size), outL(size), outR(size), expectedL(size), expectedR(size);
+        ErrorStats stats;
+
+        tap.prepare(trial.sampleRate, trial.maxBlockSize);
+        reference.prepare(trial.sampleRate);
+
+        auto setParameters = [&] {
+            const auto config = randomTap(trial, 100.0f);
+            tap.setParameters(config.delayMs, config.pan, config.lpCutoff, config.gainDb);
+            reference.setParameters(config.delayMs, config.pan, config.lpCutoff, config.gainDb);
+        };
+
+        setParameters();
+
+        for (int done = 0; done < trial.numSamples;) {
+            const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+            if (trial.chance(0.2f))
+                setParameters();
+
+            signal.fill(input.data(), numSamples);
+            std::fill(outL.begin(), outL.end(), SampleType(0));
+            std::fill(outR.begin(), outR.end(), SampleType(0));
+            tap.processBlock(input.data(), outL.data(), outR.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i) {
+                const auto out = reference.process(input[static_cast<size_t>(i)]);
+                expectedL[static_cast<size_t>(i)] = out.left;
+                expectedR[static_cast<size_t>(i)] = out.right;
+            }
+
+            stats.add(expectedL.data(), outL.data(), numSamples);
+            stats.add(expectedR.data(), outR.data(), numSamples);
+            done += numSamples;
+        }
+
+        return stats;
+    } });
+
+    // The bank's filter coefficients are computed in double and rounded once,
+    // the reference's in the sample type with std::cos, whose 1 - cos(w0)
+    // cancels badly at low cutoffs; float especially differs by more than
+    // rounding
+    const Tolerance tapBank = isFloat ? Tolerance { 2.0e-4, -90.0 } : Tolerance { 1.0e-6, -140.0 };
+
+    checks.push_back({ "TapBank::process", precision, tapBank, [](Trial& trial) {
+        const int mode = trial.random.nextInt(static_cast<int>(ModePresets::allModes.size()));
+        TapBank<SampleType> bank;
+        Reference::TapField<SampleType> reference;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        const auto size = static_cast<size_t>(trial.maxBlockSize);
+        Buffer input(size), outL(size), outR(size), expectedL(size), expectedR(size);
+        ErrorStats stats;
+
+        bank.prepare(trial.sampleRate, trial.maxBlockSize);
+        bank.setMode(mode, false);
+        reference.prepare(trial.sampleRate, mode);
+
+        // The bank restarts every lane's ramp on each change, so changes are
+        // spaced a ramp apart
+        const int rampSamples = juce::roundToInt(trial.sampleRate * 0.02);
+        int sinceChange = rampSamples;
+
+        for (int done = 0; done < trial.numSamples;) {
+            const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+            if (sinceChange >= rampSamples && trial.chance(0.3f)) {
+                const int tap = trial.random.nextInt(static_cast<int>(ModePresets::defaultNumTaps));
+                const auto config = randomTap(trial, ModePresets::maxDelayMs);
+                bank.setTap(tap, config);
+                reference.setTap(tap, config);
+                sinceChange = 0;
+            }
+
+            signal.fill(input.data(), numSamples);
+            bank.process(input.data(), outL.data(), outR.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i) {
+                const auto out = reference.process(input[static_cast<size_t>(i)]);
+                expectedL[static_cast<size_t>(i)] = out.left;
+                expectedR[static_cast<size_t>(i)] = out.right;
+            }
+
+            stats.add(expectedL.data(), outL.data(), numSamples);
+            stats.add(expectedR.data(), outR.data(), numSamples);
+            sinceChange += numSamples;
+            done += numSamples;
+        }
+
+        return stats;
+    } });
+
+    // Surround and immersive layouts, where every tap feeds each channel through
+    // its ChannelProjection gain
+    checks.push_back({ "TapBank::process multichannel", precision, tapBank, [](Trial& trial) {
+        const juce::AudioChannelSet layouts[] = { juce::AudioChannelSet::create5point1(),
+                                                  juce::AudioChannelSet::create7point1(),
+                                                  juce::AudioChannelSet::create7point1point4() };
+        const auto& layout = layouts[trial.random.nextInt(static_cast<int>(std::size(layouts)))];
+        const int mode = trial.random.nextInt(static_cast<int>(ModePresets::allModes.size()));
+        const int numChannels = layout.size();
+        TapBank<SampleType> bank;
+        Reference::ProjectedTapField<SampleType> reference;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        Buffer input(static_cast<size_t>(trial.maxBlockSize));
+        juce::AudioBuffer<SampleType> output(numChannels, trial.maxBlockSize), expected(numChannels, trial.maxBlockSize);
+        std::array<SampleType, ChannelProjection::maxChannels> frame {};
+        ErrorStats stats;
+
+        bank.prepare(trial.sampleRate, trial.maxBlockSize, layout);
+        bank.setMode(mode, false);
+        reference.prepare(trial.sampleRate, mode, layout);
+
+        // Spaced a ramp apart, as on the stereo path
+        const int rampSamples = juce::roundToInt(trial.sampleRate * 0.02);
+        int sinceChange = rampSamples;
+
+        for (int done = 0; done < trial.numSamples;) {
+            const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+            if (sinceChange >= rampSamples && trial.chance(0.3f)) {
+                const int tap = trial.random.nextInt(static_cast<int>(ModePresets::defaultNumTaps));
+                const auto config = randomTap(trial, ModePresets::maxDelayMs);
+                bank.setTap(tap, config);
+                reference.setTap(tap, config);
+                sinceChange = 0;
+            }
+
+            signal.fill(input.data(), numSamples);
+            bank.process(input.data(), output.getArrayOfWritePointers(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i) {
+                reference.process(input[static_cast<size_t>(i)], frame.data());
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    expected.setSample(channel, i, frame[static_cast<size_t>(channel)]);
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                stats.add(expected.getReadPointer(channel), output.getReadPointer(channel), numSamples);
+
+            sinceChange += numSamples;
+            done += numSamples;
+        }
+
+        return stats;
+    } });
+
+    // The convolution renderer against the tap loop it measures its responses
+    // from (itself checked above), every mode in turn. Its FFT is single
+    // precision and its responses end at the 120 dB tail, at either precision.
+    const Tolerance convolution { 2.0e-5, -110.0 };
+
+    auto addConvolverCheck = [&checks, precision, convolution](const juce::String& name, juce::AudioChannelSet layout) {
+        checks.push_back({ name, precision, convolution, [layout](Trial& trial) {
+            const int numChannels = layout.size();
+            TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+            Buffer input(static_cast<size_t>(trial.maxBlockSize));
+            juce::AudioBuffer<SampleType> output(numChannels, trial.maxBlockSize), expected(numChannels, trial.maxBlockSize);
+            ErrorStats stats;
+
+            for (int mode = 0; mode < static_cast<int>(ModePresets::allModes.size()); ++mode) {
+                TapBank<SampleType> bank;
+                FieldConvolver<SampleType> convolver;
+
+                bank.prepare(trial.sampleRate, trial.maxBlockSize, layout);
+                bank.setMode(mode, false);
+                convolver.prepare(trial.sampleRate, trial.maxBlockSize, layout);
+                convolver.setMode(mode, false);
+                convolver.reset();
+
+                for (int done = 0; done < trial.numSamples;) {
+                    const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+                    signal.fill(input.data(), numSamples);
+                    bank.process(input.data(), expected.getArrayOfWritePointers(), numSamples);
+                    convolver.process(input.data(), output.getArrayOfWritePointers(), numSamples);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        stats.add(expected.getReadPointer(channel), output.getReadPointer(channel), numSamples);
+
+                    done += numSamples;
+                }
+            }
+
+            return stats;
+        } });
+    };
+
+    addConvolverCheck("FieldConvolver::process stereo", juce::AudioChannelSet::stereo());
+    addConvolverCheck("FieldConvolver::process 7.1.4", juce::AudioChannelSet::create7point1point4());
+
+    // The exact curve at 1x, and the realtime lookup table, which trades a
+    // little accuracy for speed; each alone and fused with the soft ceiling
+    auto addExciterCheck = [&checks, precision](const juce::String& name, Tolerance tolerance, bool useTable,
+                                                bool withCeiling) {
+        checks.push_back({ name, precision, tolerance, [useTable, withCeiling](Trial& trial) {
+            HarmonicGenerator<SampleType> exciter;
+            Reference::Exciter<SampleType> reference;
+            TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+            Buffer buffer(static_cast<size_t>(trial.maxBlockSize)), expected(buffer.size());
+            ErrorStats stats;
+
+            exciter.prepare(trial.maxBlockSize, ExciterOversampling::x1, false);
+            exciter.setUseLookupTable(useTable);
+
+            auto setExcitation = [&] {
+                const float energy = trial.chance(0.1f) ? 0.0f : trial.between(0.0f, 100.0f);
+                const float profile = trial.random.nextFloat();
+
+                exciter.setExcitation(energy, profile);
+                reference.setExcitation(energy, profile);
+
+                if (useTable)
+                    exciter.buildCurveTable(energy, profile);
+            };
+
+            setExcitation();
+
+            for (int done = 0; done < trial.numSamples;) {
+                const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+                if (trial.chance(0.3f))
+                    setExcitation();
+
+                signal.fill(buffer.data(), numSamples);
+
+                for (int i = 0; i < numSamples; ++i) {
+                    const SampleType excited = reference.process(buffer[static_cast<size_t>(i)]);
+                    expected[static_cast<size_t>(i)] = withCeiling ? Reference::softCeiling(excited) : excited;
+                }
+
+                if (withCeiling)
+                    exciter.processBlockWithCeiling(buffer.data(), numSamples);
+                else
+                    exciter.processBlock(buffer.data(), numSamples);
+                stats.add(expected.data(), buffer.data(), numSamples);
+                done += numSamples;
+            }
+
+            return stats;
+        } });
+    };
+
+    // The ceiling's knee steepens the exact curve's rounding by up to 7x
+    const Tolerance knee = isFloat ? Tolerance { 4.0e-6, -125.0 } : Tolerance { 1.0e-13, -270.0 };
+
+    addExciterCheck("HarmonicGenerator::processBlock", rounding, false, false);
+    addExciterCheck("HarmonicGenerator::processBlock lookup table", { 1.0e-4, -90.0 }, true, false);
+    addExciterCheck("HarmonicGenerator::processBlockWithCeiling", knee, false, true);
+    addExciterCheck("HarmonicGenerator::processBlockWithCeiling lookup table", { 1.0e-4, -90.0 }, true, true);
+
+    // The realtime (2x, IIR) and offline (4x, linear-phase FIR) tiers on the
+    // exact curve, with ENERGY often at 0 so the bypass delay and the filters'
+    // warm-up on leaving it run many times per trial. Both sides run the same
+    // JUCE filters, so only the curve's rounding, filtered, separates them.
+    auto addOversampledExciterCheck = [&checks, precision, knee](const juce::String& name, ExciterOversampling factor,
+                                                                 bool linearPhase) {
+        checks.push_back({ name, precision, knee, [factor, linearPhase](Trial& trial) {
+            HarmonicGenerator<SampleType> exciter;
+            Reference::OversampledExciter<SampleType> reference;
+            TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+            Buffer buffer(static_cast<size_t>(trial.maxBlockSize)), expected(buffer.size());
+            ErrorStats stats;
+
+            exciter.prepare(trial.maxBlockSize, factor, linearPhase);
+            exciter.setUseLookupTable(false);
+            reference.prepare(trial.maxBlockSize, static_cast<int>(factor), linearPhase);
+
+            auto setExcitation = [&] {
+                const float energy = trial.chance(0.4f) ? 0.0f : trial.between(0.0f, 100.0f);
+                const float profile = trial.random.nextFloat();
+
+                exciter.setExcitation(energy, profile);
+                reference.setExcitation(energy, profile);
+            };
+
+            setExcitation();
+
+            for (int done = 0; done < trial.numSamples;) {
+                const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+                if (trial.chance(0.3f))
+                    setExcitation();
+
+                signal.fill(buffer.data(), numSamples);
+                std::copy(buffer.begin(), buffer.begin() + numSamples, expected.begin());
+
+                reference.process(expected.data(), numSamples);
+                exciter.processBlock(buffer.data(), numSamples);
+                stats.add(expected.data(), buffer.data(), numSamples);
+                done += numSamples;
+            }
+
+            return stats;
+        } });
+    };
+
+    addOversampledExciterCheck("HarmonicGenerator::processBlock 2x realtime", ExciterOversampling::x2, false);
+    addOversampledExciterCheck("HarmonicGenerator::processBlock 4x offline", ExciterOversampling::x4, true);
+
+    // The limiter on bursts driven up to 12 dB hotter still, between quiet
+    // stretches long enough for its gain to settle back to unity, so both
+    // the limiting path and the unity fast path run, and the fast path picks
+    // up after every release. Against a reference that scans the whole window
+    // for its minimum and re-sums the moving average every sample; the
+    // block's returned gain is compared too.
+    auto runLimiter = [](Trial& trial, auto&& compare) {
+        const float lookaheadMs = trial.between(LookaheadLimiter<SampleType>::minLookaheadMs,
+                                                LookaheadLimiter<SampleType>::maxLookaheadMs);
+        const int settlingSamples = static_cast<int>(std::ceil(LookaheadLimiter<SampleType>::getSettlingSeconds(trial.sampleRate, lookaheadMs)
+                                                               * trial.sampleRate));
+        const int totalSamples = trial.numSamples + 2 * settlingSamples;
+        DspArena arena;
+        LookaheadLimiter<SampleType> limiter;
+        Reference::LookaheadLimiter<SampleType> reference;
+        TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+        Buffer buffer(static_cast<size_t>(trial.maxBlockSize)), expected(buffer.size());
+
+        arena.build([&](DspArena& a) { limiter.prepare(trial.sampleRate, lookaheadMs, trial.maxBlockSize, a); });
+        reference.prepare(trial.sampleRate, lookaheadMs);
+
+        bool hot = false;
+        int stretchRemaining = 0;
+        SampleType drive = 1;
+
+        for (int done = 0; done < totalSamples;) {
+            const int numSamples = trial.nextBlockSize(totalSamples - done);
+            SampleType expectedLowest = 1;
+
+            if (stretchRemaining <= 0) {
+                hot = ! hot;
+                drive = hot ? static_cast<SampleType>(juce::Decibels::decibelsToGain(trial.between(0.0f, 12.0f))) : SampleType(0.01);
+                stretchRemaining = hot ? static_cast<int>(trial.between(0.01f, 0.2f) * static_cast<float>(trial.sampleRate))
+                                       : settlingSamples + static_cast<int>(trial.between(0.0f, 0.1f) * static_cast<float>(trial.sampleRate));
+            }
+
+            signal.fill(buffer.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i) {
+                buffer[static_cast<size_t>(i)] *= drive;
+                expected[static_cast<size_t>(i)] = reference.process(buffer[static_cast<size_t>(i)]);
+                expectedLowest = juce::jmin(expectedLowest, reference.getGain());
+            }
+
+            const SampleType lowest = limiter.process(buffer.data(), numSamples);
+            compare(expected.data(), buffer.data(), numSamples, expectedLowest, lowest);
+            stretchRemaining -= numSamples;
+            done += numSamples;
+        }
+    };
+
+    // Only the running sum differs from the reference's re-summed one, by
+    // double rounding
+    const Tolerance limiter = isFloat ? Tolerance { 1.0e-6, -130.0 } : Tolerance { 1.0e-12, -240.0 };
+
+    checks.push_back({ "LookaheadLimiter::process", precision, limiter, [runLimiter](Trial& trial) {
+        ErrorStats stats;
+
+        runLimiter(trial, [&](const SampleType* expected, const SampleType* output, int numSamples,
+                              SampleType expectedLowest, SampleType lowest) {
+            stats.add(expected, output, numSamples);
+            stats.add(&expectedLowest, &lowest, 1);
+        });
+
+        return stats;
+    } });
+
+    // The output's own 4x true peak against the ceiling: only overshoot counts
+    // as error, and none is allowed beyond rounding
+    checks.push_back({ "LookaheadLimiter::process true peak", precision, rounding, [runLimiter](Trial& trial) {
+        Reference::TruePeak<SampleType> meter;
+        ErrorStats stats;
+
+        runLimiter(trial, [&](const SampleType*, const SampleType* output, int numSamples, SampleType, SampleType) {
+            for (int i = 0; i < numSamples; ++i) {
+                const SampleType peak = meter.process(output[i]);
+                const SampleType allowed = juce::jmin(peak, LookaheadLimiter<SampleType>::ceiling);
+                stats.add(&allowed, &peak, 1);
+            }
+        });
+
+        return stats;
+    } });
+
+    // Whole plugin, offline at 1x so the exciter runs the exact curve, with
+    // ENERGY and FIELD AMOUNT automated between host blocks. Silent stretches
+    // let it fall asleep and wake again. With the lookahead limiter, the
+    // reference delays its dry path by the limiter's latency, and a reported
+    // latency that differs from it fails the check by that many samples.
+    // The reference never sleeps, so the tail it still carries below the
+    // silence threshold bounds the largest error at either precision
+    const Tolerance processor = isFloat ? Tolerance { 2.0e-6, -120.0 } : Tolerance { 2.0e-6, -150.0 };
+
+    auto addProcessorCheck = [&checks, precision, processor](const juce::String& name, bool useLimiter) {
+        checks.push_back({ name, precision, processor, [useLimiter](Trial& trial) {
+            const int mode = trial.random.nextInt(static_cast<int>(ModePresets::allModes.size()));
+            const float lookaheadMs = useLimiter ? trial.between(LookaheadLimiter<SampleType>::minLookaheadMs,
+                                                                 LookaheadLimiter<SampleType>::maxLookaheadMs)
+                                                 : 0.0f;
+            FieldAudioProcessor processor;
+            Reference::Chain<SampleType> reference;
+            TestSignal<SampleType> signal(trial.random, trial.sampleRate);
+            const auto size = static_cast<size_t>(trial.maxBlockSize);
+            juce::AudioBuffer<SampleType> buffer(2, trial.maxBlockSize);
+            Buffer expectedL(size), expectedR(size);
+            juce::MidiBuffer midi;
+            ErrorStats stats;
+
+            // Parameters snap to their 0.1 steps, so the reference reads them back
+            auto setParameter = [&processor](const juce::String& parameterID, float value) {
+                auto* param = processor.apvts.getParameter(parameterID);
+                param->setValueNotifyingHost(param->convertTo0to1(value));
+                return processor.apvts.getRawParameterValue(parameterID)->load();
+            };
+
+            setParameter("mode", static_cast<float>(mode));
+            float energy = setParameter("energy", trial.between(0.0f, 100.0f));
+            float fieldAmount = setParameter("field_amount", trial.between(0.0f, 100.0f));
+
+            processor.setOversamplingTiers(ExciterOversampling::x1, ExciterOversampling::x1);
+
+            if (useLimiter)
+                processor.setLookaheadLimiter(true, lookaheadMs);
+
+            processor.setNonRealtime(true);
+            processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                                : juce::AudioProcessor::singlePrecision);
+            processor.setRateAndBufferSizeDetails(trial.sampleRate, trial.maxBlockSize);
+            processor.prepareToPlay(trial.sampleRate, trial.maxBlockSize);
+            reference.prepare(trial.sampleRate, mode, energy, lookaheadMs);
+
+            stats.maxAbsError = std::abs(processor.getLatencySamples() - reference.getLatencySamples());
+
+            for (int done = 0; done < trial.numSamples;) {
+                const int numSamples = trial.nextBlockSize(trial.numSamples - done);
+
+                if (trial.chance(0.3f))
+                    energy = setParameter("energy", trial.chance(0.1f) ? 0.0f : trial.between(0.0f, 100.0f));
+
+                if (trial.chance(0.2f))
+                    fieldAmount = setParameter("field_amount", trial.between(0.0f, 100.0f));
+
+                buffer.setSize(2, numSamples, false, false, true);
+                signal.fill(buffer.getWritePointer(0), numSamples);
+                signal.fill(buffer.getWritePointer(1), numSamples);
+
+                std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + numSamples, expectedL.begin());
+                std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + numSamples, expectedR.begin());
+                reference.process(expectedL.data(), expectedR.data(), numSamples, energy, fieldAmount);
+
+                processor.processBlock(buffer, midi);
+
+                stats.add(expectedL.data(), buffer.getReadPointer(0), numSamples);
+                stats.add(expectedR.data(), buffer.getReadPointer(1), numSamples);
+                done += numSamples;
+            }
+
+            return stats;
+        } });
+    };
+
+    addProcessorCheck("FieldAudioProcessor::processBlock", false);
+    addProcessorCheck("FieldAudioProcessor::processBlock lookahead limiter", true);
+}
+
+std::vector<Check> createChecks()
+{
+    std::vector<Check> checks;
+    addChecks<float>(checks, "float");
+    addChecks<double>(checks, "double");
+    return checks;
+}
+
+//==============================================================================
+juce::String formatDb(double db)
+{
+    return std::isinf(db) ? juce::String("-inf") : juce::String(db, 1);
+}
+
+void printUsage()
+{
+    std::cout << "Usage: field_validate [options]\n"
+                 "\n"
+                 "Options:\n"
+                 "  --seed <n>             Random seed; failures print the seed to reproduce them\n"
+                 "  --trials <n>           Random configurations per kernel (default: 6)\n"
+                 "  --seconds <s>          Audio per trial (default: 0.5)\n"
+                 "  --filter <text>        Only run kernels whose name contains text\n"
+                 "  --precision <p>        float or double (default: both)\n";
+}
+
+bool parseArguments(int argc, char* argv[], ValidateOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        auto name = arg.upToFirstOccurrenceOf("=", false, false);
+        juce::String value;
+
+        // Accept both "--name value" and "--name=value"
+        if (arg.containsChar('=')) {
+            value = arg.fromFirstOccurrenceOf("=", false, false);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            return false;
+        }
+
+        if (name == "--seed")
+            options.seed = value.getLargeIntValue();
+        else if (name == "--trials")
+            options.trials = juce::jmax(1, value.getIntValue());
+        else if (name == "--seconds")
+            options.seconds = juce::jmax(0.01, value.getDoubleValue());
+        else if (name == "--filter")
+            options.filter = value;
+        else if (name == "--precision" && (value == "float" || value == "double"))
+            options.precision = value;
+        else
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    ValidateOptions options;
+
+    if (! parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // The processor relies on the message manager (parameter state, timers)
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::cout << "seed " << options.seed << ", " << options.trials << " trials of " << options.seconds << " s per kernel\n\n"
+              << std::left << std::setw(60) << "kernel" << std::setw(8) << "type"
+              << std::setw(14) << "max error" << std::setw(12) << "null dB" << "limits\n";
+
+    int numFailed = 0;
+    int index = 0;
+
+    for (const auto& check : createChecks()) {
+        ++index;
+
+        if (options.filter.isNotEmpty() && ! check.name.contains(options.filter))
+            continue;
+
+        if (options.precision.isNotEmpty() && options.precision != check.precision)
+            continue;
+
+        ErrorStats total;
+
+        // Every kernel sees its own reproducible sequence of configurations
+        juce::Random random(options.seed + index * 1000003);
+
+        for (int t = 0; t < options.trials; ++t) {
+            const double sampleRate = sampleRates[random.nextInt(static_cast<int>(std::size(sampleRates)))];
+            const int maxBlockSize = maxBlockSizes[random.nextInt(static_cast<int>(std::size(maxBlockSizes)))];
+            Trial trial { random, sampleRate, maxBlockSize, static_cast<int>(options.seconds * sampleRate) };
+
+            total.merge(check.run(trial));
+        }
+
+        const bool passed = total.maxAbsError <= check.tolerance.maxAbsError
+                         && total.getNullDepthDb() <= check.tolerance.nullDepthDb;
+
+        if (! passed)
+            ++numFailed;
+
+        std::cout << std::left << std::setw(60) << check.name << std::setw(8) << check.precision
+                  << std::setw(14) << juce::String(total.maxAbsError, 3, true)
+                  << std::setw(12) << formatDb(total.getNullDepthDb())
+                  << juce::String(check.tolerance.maxAbsError, 1, true) << ", " << formatDb(check.tolerance.nullDepthDb) << " dB"
+                  << (passed ? "" : "  FAILED") << '\n';
+    }
+
+    std::cout << '\n' << (numFailed == 0 ? juce::String("All kernels match their references")
+                                         : juce::String(numFailed) + " kernel(s) outside tolerance")
+              << '\n';
+
+    return numFailed == 0 ? 0 : 1;
+}
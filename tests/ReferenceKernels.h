@@ -0,0 +1,659 @@
+// ReferenceKernels.h
+// FIELD — Projection Engine
+// Frozen scalar reference implementations of the DSP kernels, one sample at a time
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ChannelProjection.h"
+#include "ModePresets.h"
+#include "OutputMeter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+/**
+ * The signal chain as it behaved before any of it was vectorised or
+ * restructured: plain per-sample loops, modulo indexing, coefficients
+ * computed on the spot. Nothing here is tuned, and nothing here should
+ * change; field_validate runs the optimised kernels in src/ against these.
+ *
+ * If a deliberate change of behaviour lands in src/, update the matching
+ * kernel here in the same commit and say so in its message.
+ */
+namespace Reference {
+
+//==============================================================================
+// Circular buffer with linear interpolation (DelayLine::process)
+template <typename SampleType>
+class DelayLine {
+public:
+    void prepare(double newSampleRate, float newMaxDelayMs) {
+        sampleRate = newSampleRate;
+        maxDelayMs = newMaxDelayMs;
+        buffer.assign(static_cast<size_t>(std::ceil(sampleRate * maxDelayMs / 1000.0)) + 2, SampleType(0));
+        writeIndex = 0;
+    }
+
+    void setDelayMs(float delayMs) {
+        const auto delaySamples = std::clamp(delayMs, 0.0f, maxDelayMs) * sampleRate / 1000.0;
+        wholeSamples = static_cast<size_t>(delaySamples);
+        fraction = static_cast<SampleType>(delaySamples - static_cast<double>(wholeSamples));
+    }
+
+    SampleType process(SampleType input) {
+        const size_t size = buffer.size();
+        buffer[writeIndex] = input;
+
+        // The sample wholeSamples behind the write position, towards the one before it
+        const SampleType newer = buffer[(writeIndex + size - wholeSamples) % size];
+        const SampleType older = buffer[(writeIndex + 2 * size - wholeSamples - 1) % size];
+
+        writeIndex = (writeIndex + 1) % size;
+        return newer + fraction * (older - newer);
+    }
+
+private:
+    std::vector<SampleType> buffer;
+    size_t writeIndex = 0;
+    size_t wholeSamples = 0;
+    SampleType fraction = 0;
+    float maxDelayMs = 100.0f;
+    double sampleRate = 44100.0;
+};
+
+//==============================================================================
+// RBJ biquad, Direct Form II Transposed (BiquadFilter)
+template <typename SampleType>
+class Biquad {
+public:
+    enum class Type { LowPass, HighPass, BandPass };
+
+    void prepare(double newSampleRate) {
+        sampleRate = newSampleRate;
+        z1 = z2 = 0;
+        update();
+    }
+
+    void setParameters(Type newType, float freqHz, float newQ) {
+        type = newType;
+        frequency = std::clamp(freqHz, 20.0f, 20000.0f);
+        q = std::clamp(newQ, 0.1f, 10.0f);
+        update();
+    }
+
+    SampleType process(SampleType input) {
+        const SampleType output = b0 * input + z1;
+        z1 = b1 * input - a1 * output + z2;
+        z2 = b2 * input - a2 * output;
+        return output;
+    }
+
+private:
+    void update() {
+        const SampleType one = 1, two = 2;
+        const auto w0 = static_cast<SampleType>(2.0 * 3.14159265358979323846 * frequency / sampleRate);
+        const SampleType cosW0 = std::cos(w0);
+        const SampleType alpha = std::sin(w0) / (two * static_cast<SampleType>(q));
+        const SampleType a0 = one + alpha;
+
+        switch (type) {
+            case Type::LowPass:  b0 = (one - cosW0) / two; b1 = one - cosW0;    b2 = b0;     break;
+            case Type::HighPass: b0 = (one + cosW0) / two; b1 = -(one + cosW0); b2 = b0;     break;
+            case Type::BandPass: b0 = alpha;               b1 = 0;              b2 = -alpha; break;
+        }
+
+        a1 = -two * cosW0;
+        a2 = one - alpha;
+
+        b0 /= a0;
+        b1 /= a0;
+        b2 /= a0;
+        a1 /= a0;
+        a2 /= a0;
+    }
+
+    Type type = Type::LowPass;
+    float frequency = 6000.0f;
+    float q = 0.707f;
+    double sampleRate = 44100.0;
+
+    SampleType b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+    SampleType z1 = 0, z2 = 0;
+};
+
+//==============================================================================
+// Delay → low-pass → gain → constant-power pan, gain and pan ramped
+// linearly over 20 ms (TapProcessor::process)
+template <typename SampleType>
+class Tap {
+public:
+    struct StereoSample {
+        SampleType left;
+        SampleType right;
+    };
+
+    void prepare(double sampleRate) {
+        delayLine.prepare(sampleRate, 100.0f);
+        filter.prepare(sampleRate);
+        rampLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.02));
+    }
+
+    // Jump to the last parameters set, ending any ramp
+    void settle() {
+        gain = targetGain;
+        panL = targetPanL;
+        panR = targetPanR;
+        rampRemaining = 0;
+    }
+
+    void setParameters(float delayMs, float pan, float lpCutoff, float gainDb) {
+        delayLine.setDelayMs(delayMs);
+        filter.setParameters(Biquad<SampleType>::Type::LowPass, lpCutoff, 0.707f);
+
+        const auto angle = static_cast<SampleType>((juce::jlimit(-100.0f, 100.0f, pan) + 100.0f) / 200.0f)
+                           * SampleType(3.14159265358979323846) * SampleType(0.5);
+        targetPanL = std::cos(angle);
+        targetPanR = std::sin(angle);
+        targetGain = juce::Decibels::decibelsToGain(static_cast<SampleType>(gainDb));
+
+        const SampleType scale = SampleType(1) / static_cast<SampleType>(rampLength);
+        gainStep = (targetGain - gain) * scale;
+        panStepL = (targetPanL - panL) * scale;
+        panStepR = (targetPanR - panR) * scale;
+        rampRemaining = rampLength;
+    }
+
+    StereoSample process(SampleType input) {
+        const SampleType filtered = filter.process(delayLine.process(input));
+
+        // The ramp lands exactly on its targets
+        if (rampRemaining > 0) {
+            if (--rampRemaining == 0) {
+                gain = targetGain;
+                panL = targetPanL;
+                panR = targetPanR;
+            } else {
+                gain += gainStep;
+                panL += panStepL;
+                panR += panStepR;
+            }
+        }
+
+        const SampleType gained = filtered * gain;
+        return { gained * panL, gained * panR };
+    }
+
+private:
+    DelayLine<SampleType> delayLine;
+    Biquad<SampleType> filter;
+
+    SampleType gain = SampleType(0.25), targetGain = SampleType(0.25), gainStep = 0;
+    SampleType panL = SampleType(0.707), targetPanL = SampleType(0.707), panStepL = 0;
+    SampleType panR = SampleType(0.707), targetPanR = SampleType(0.707), panStepR = 0;
+    int rampLength = 1;
+    int rampRemaining = 0;
+};
+
+//==============================================================================
+// Even-dominant waveshaper on the exact curve at the base rate
+// (HarmonicGenerator::processSample)
+template <typename SampleType>
+class Exciter {
+public:
+    void setExcitation(float energyPercent, float profile) {
+        energy = juce::jlimit(0.0f, 100.0f, energyPercent) / 100.0f;
+        profile = juce::jlimit(0.0f, 1.0f, profile);
+
+        const float energyScaled = std::pow(energy, 1.5f);
+        const float oddThreshold = (profile > 0.6f && energy > 0.4f) ? energy - 0.4f : 0.0f;
+        even = juce::jlimit(0.0f, 0.5f, energyScaled * (0.2f + profile * 0.3f));
+        odd = juce::jlimit(0.0f, 0.12f, oddThreshold * 0.15f * profile);
+    }
+
+    SampleType process(SampleType x) const {
+        using Fast = juce::dsp::FastMathApproximations;
+
+        if (energy < 0.001f) {
+            return x;
+        }
+
+        const auto e = static_cast<SampleType>(even);
+        const auto o = static_cast<SampleType>(odd);
+        const SampleType evenHarm = e * x * x * Fast::tanh(x);
+        const SampleType oddHarm = o * (x * x * x * SampleType(0.1) + Fast::tanh(x * SampleType(1.5)) * SampleType(0.05));
+        return Fast::tanh((x + evenHarm + oddHarm) * SampleType(0.9));
+    }
+
+private:
+    float energy = 0.0f;
+    float even = 0.0f;
+    float odd = 0.0f;
+};
+
+//==============================================================================
+// Exciter at 2x or 4x between JUCE's half-band filters. At ENERGY 0 the
+// filters are skipped and the input only delayed by their latency; coming
+// back, they restart from silence on the input they missed
+// (HarmonicGenerator::processBlock, oversampled)
+template <typename SampleType>
+class OversampledExciter {
+public:
+    void prepare(int newMaxBlockSize, int factorLog2, bool linearPhase) {
+        using Oversampling = juce::dsp::Oversampling<SampleType>;
+        const auto filterType = linearPhase ? Oversampling::filterHalfBandFIREquiripple
+                                            : Oversampling::filterHalfBandPolyphaseIIR;
+
+        oversampler = std::make_unique<Oversampling>(1, static_cast<size_t>(factorLog2), filterType, linearPhase, true);
+        oversampler->initProcessing(static_cast<size_t>(newMaxBlockSize));
+        latency = juce::roundToInt(oversampler->getLatencyInSamples());
+        maxBlockSize = newMaxBlockSize;
+        input.clear();
+        wasBypassed = false;
+    }
+
+    void setExcitation(float energyPercent, float profile) {
+        exciter.setExcitation(energyPercent, profile);
+        bypassed = juce::jlimit(0.0f, 100.0f, energyPercent) / 100.0f < 0.001f;
+    }
+
+    void process(SampleType* samples, int numSamples) {
+        const auto start = static_cast<int>(input.size());
+        input.insert(input.end(), samples, samples + numSamples);
+
+        if (bypassed) {
+            for (int i = 0; i < numSamples; ++i) {
+                samples[i] = inputAt(start + i - latency);
+            }
+
+            wasBypassed = true;
+            return;
+        }
+
+        if (wasBypassed) {
+            oversampler->reset();
+            std::vector<SampleType> missed(static_cast<size_t>(latency));
+
+            for (int i = 0; i < latency; ++i) {
+                missed[static_cast<size_t>(i)] = inputAt(start - latency + i);
+            }
+
+            for (int done = 0; done < latency; done += maxBlockSize) {
+                SampleType* channels[] = { missed.data() + done };
+                juce::dsp::AudioBlock<SampleType> block(channels, 1, static_cast<size_t>(juce::jmin(maxBlockSize, latency - done)));
+                oversampler->processSamplesUp(block);
+                oversampler->processSamplesDown(block);
+            }
+
+            wasBypassed = false;
+        }
+
+        SampleType* channels[] = { samples };
+        juce::dsp::AudioBlock<SampleType> block(channels, 1, static_cast<size_t>(numSamples));
+        auto upsampled = oversampler->processSamplesUp(block);
+        SampleType* shaped = upsampled.getChannelPointer(0);
+
+        for (size_t i = 0; i < upsampled.getNumSamples(); ++i) {
+            shaped[i] = exciter.process(shaped[i]);
+        }
+
+        oversampler->processSamplesDown(block);
+    }
+
+private:
+    // Silence before the first sample
+    SampleType inputAt(int index) const {
+        return index >= 0 ? input[static_cast<size_t>(index)] : SampleType(0);
+    }
+
+    Exciter<SampleType> exciter;
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler;
+    std::vector<SampleType> input;      // Everything processed so far
+    int latency = 0;
+    int maxBlockSize = 1;
+    bool bypassed = true;
+    bool wasBypassed = false;
+};
+
+//==============================================================================
+// Soft-knee limiter at -0.5 dBFS (SoftCeiling)
+template <typename SampleType>
+SampleType softCeiling(SampleType x) {
+    const SampleType threshold = SampleType(0.891);
+    const SampleType kneeWidth = SampleType(0.15);
+    const SampleType magnitude = std::abs(x);
+
+    if (magnitude < threshold) {
+        return x;
+    }
+
+    if (magnitude < threshold + kneeWidth) {
+        const SampleType knee = (magnitude - threshold) / kneeWidth;
+        return x * (SampleType(1) - knee * knee * SampleType(0.5));
+    }
+
+    return (x >= SampleType(0) ? SampleType(1) : SampleType(-1)) * (threshold + kneeWidth * SampleType(0.5));
+}
+
+//==============================================================================
+// BS.1770 true-peak estimate around the newest sample: the 4x FIR's four
+// phases, which interpolate between the samples 6 and 5 behind it, and those
+// two samples themselves (OutputMeter, LookaheadLimiter's detector)
+template <typename SampleType>
+class TruePeak {
+public:
+    static constexpr int delay = 6;
+
+    SampleType process(SampleType input) {
+        history.insert(history.begin(), input);
+        history.pop_back();
+
+        SampleType peak = std::max(std::abs(history[delay]), std::abs(history[delay - 1]));
+
+        for (const auto& phase : OutputMeter<SampleType>::coefficients) {
+            SampleType sum = 0;
+
+            for (size_t tap = 0; tap < history.size(); ++tap) {
+                sum += static_cast<SampleType>(phase[tap]) * history[tap];
+            }
+
+            peak = std::max(peak, std::abs(sum));
+        }
+
+        return peak;
+    }
+
+private:
+    std::vector<SampleType> history = std::vector<SampleType>(OutputMeter<SampleType>::tapsPerPhase, SampleType(0));
+};
+
+//==============================================================================
+// Lookahead limiter with the window minimum found by scanning every required
+// gain in the window, and the moving average re-summed every sample. Each
+// peak's requirement, 0.01 dB under the ceiling, covers every sample its
+// estimate was drawn from (LookaheadLimiter)
+template <typename SampleType>
+class LookaheadLimiter {
+public:
+    static constexpr SampleType ceiling = SampleType(0.891);
+    static constexpr SampleType target = ceiling * SampleType(0.999);
+
+    void prepare(double sampleRate, float lookaheadMs) {
+        lookahead = juce::jmax(1, juce::roundToInt(sampleRate * std::clamp(lookaheadMs, 0.5f, 5.0f) / 1000.0));
+        releaseCoefficient = static_cast<SampleType>(1.0 - std::exp(-1.0 / (0.05 * sampleRate)));
+        input.assign(static_cast<size_t>(getLatencySamples()), SampleType(0));
+        required.assign(static_cast<size_t>(lookahead + span), SampleType(1));
+        releasedGains.assign(static_cast<size_t>(lookahead), SampleType(1));
+        released = SampleType(1);
+    }
+
+    int getLatencySamples() const { return lookahead + span - 1; }
+
+    // The gain applied to the output sample last returned
+    SampleType getGain() const { return gain; }
+
+    SampleType process(SampleType x) {
+        const SampleType peak = detector.process(x);
+        required.erase(required.begin());
+        required.push_back(peak > target ? target / peak : SampleType(1));
+
+        const SampleType lowestInWindow = *std::min_element(required.begin(), required.end());
+
+        released = lowestInWindow < released ? lowestInWindow
+                                             : released + (lowestInWindow - released) * releaseCoefficient;
+
+        if (released >= SampleType(1) - SampleType(1.0e-5)) {
+            released = lowestInWindow;
+        }
+
+        releasedGains.erase(releasedGains.begin());
+        releasedGains.push_back(released);
+
+        double sum = 0.0;
+
+        for (const auto g : releasedGains) {
+            sum += static_cast<double>(g);
+        }
+
+        gain = std::min(SampleType(1), static_cast<SampleType>(sum / static_cast<double>(lookahead)));
+
+        input.push_back(x);
+        const SampleType delayed = input.front();
+        input.erase(input.begin());
+        return delayed * gain;
+    }
+
+private:
+    TruePeak<SampleType> detector;
+    std::vector<SampleType> input;          // The last getLatencySamples() inputs
+    static constexpr int span = OutputMeter<SampleType>::tapsPerPhase;
+
+    std::vector<SampleType> required;       // Every sample's required gain, over lookahead + span samples
+    std::vector<SampleType> releasedGains;  // The last lookahead released gains
+    SampleType released = SampleType(1);
+    SampleType releaseCoefficient = SampleType(0);
+    SampleType gain = SampleType(1);
+    int lookahead = 1;
+};
+
+//==============================================================================
+// One mode's hand-tuned taps, each run as its own Tap and summed (TapBank, stereo)
+template <typename SampleType>
+class TapField {
+public:
+    void prepare(double sampleRate, int modeIndex) {
+        const auto& mode = ModePresets::getMode(modeIndex);
+        taps.resize(mode.taps.size());
+
+        for (size_t i = 0; i < taps.size(); ++i) {
+            const auto& config = mode.taps[i];
+            taps[i].prepare(sampleRate);
+            taps[i].setParameters(config.delayMs, config.pan, config.lpCutoff, config.gainDb);
+            taps[i].settle();   // Start on the preset, not ramping towards it
+        }
+    }
+
+    // Retune one tap; gain and pan ramp to the new values
+    void setTap(int tap, const ModePresets::TapConfig& config) {
+        taps[static_cast<size_t>(tap)].setParameters(config.delayMs, config.pan, config.lpCutoff, config.gainDb);
+    }
+
+    typename Tap<SampleType>::StereoSample process(SampleType input) {
+        typename Tap<SampleType>::StereoSample sum { 0, 0 };
+
+        for (auto& tap : taps) {
+            const auto out = tap.process(input);
+            sum.left += out.left;
+            sum.right += out.right;
+        }
+
+        return sum;
+    }
+
+private:
+    std::vector<Tap<SampleType>> taps;
+};
+
+//==============================================================================
+// One mode's taps on a surround or immersive layout: each tap's filtered
+// output times its ChannelProjection gain on every channel, ramped linearly
+// over 20 ms like Tap's pan (TapBank, multichannel)
+template <typename SampleType>
+class ProjectedTapField {
+public:
+    void prepare(double sampleRate, int modeIndex, const juce::AudioChannelSet& newLayout) {
+        const auto& mode = ModePresets::getMode(modeIndex);
+        layout = newLayout;
+        rampLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.02));
+        taps.resize(mode.taps.size());
+
+        for (size_t i = 0; i < taps.size(); ++i) {
+            taps[i].delayLine.prepare(sampleRate, 100.0f);
+            taps[i].filter.prepare(sampleRate);
+            setTap(static_cast<int>(i), mode.taps[i]);
+
+            // Start on the preset, not ramping towards it
+            taps[i].gains = taps[i].targets;
+            taps[i].rampRemaining = 0;
+        }
+    }
+
+    // Retune one tap; its channel gains ramp to the new values
+    void setTap(int tap, const ModePresets::TapConfig& config) {
+        auto& t = taps[static_cast<size_t>(tap)];
+        const auto channelGains = ChannelProjection::getTapGains(config.pan, layout);
+        const double gain = juce::Decibels::decibelsToGain(static_cast<double>(config.gainDb));
+
+        t.delayLine.setDelayMs(config.delayMs);
+        t.filter.setParameters(Biquad<SampleType>::Type::LowPass, config.lpCutoff, 0.707f);
+
+        for (size_t c = 0; c < t.targets.size(); ++c) {
+            t.targets[c] = static_cast<SampleType>(channelGains[c] * gain);
+            t.steps[c] = (t.targets[c] - t.gains[c]) / static_cast<SampleType>(rampLength);
+        }
+
+        t.rampRemaining = rampLength;
+    }
+
+    // One input sample into a sample on each of the layout's channels
+    void process(SampleType input, SampleType* output) {
+        std::fill(output, output + layout.size(), SampleType(0));
+
+        for (auto& t : taps) {
+            const SampleType filtered = t.filter.process(t.delayLine.process(input));
+
+            // The ramp lands exactly on its targets
+            if (t.rampRemaining > 0) {
+                const bool landing = --t.rampRemaining == 0;
+
+                for (size_t c = 0; c < t.gains.size(); ++c) {
+                    t.gains[c] = landing ? t.targets[c] : t.gains[c] + t.steps[c];
+                }
+            }
+
+            for (int c = 0; c < layout.size(); ++c) {
+                output[c] += filtered * t.gains[static_cast<size_t>(c)];
+            }
+        }
+    }
+
+private:
+    using Gains = std::array<SampleType, ChannelProjection::maxChannels>;
+
+    struct ProjectedTap {
+        DelayLine<SampleType> delayLine;
+        Biquad<SampleType> filter;
+        Gains gains {}, targets {}, steps {};
+        int rampRemaining = 0;
+    };
+
+    juce::AudioChannelSet layout;
+    std::vector<ProjectedTap> taps;
+    int rampLength = 1;
+};
+
+//==============================================================================
+// The stereo plugin at 1x oversampling on the exact exciter curve, with the
+// tap renderer and a fixed mode (FieldAudioProcessor::processBlock offline):
+// mono sum → -6 dB → exciter → ceiling → taps → compensation → dry/wet.
+// ENERGY ramps across each host block in 32-sample steps, each step using
+// the ramp's value at its midpoint; FIELD AMOUNT glides over 20 ms. With the
+// lookahead limiter in the ceiling's place, the dry path is delayed by its
+// latency.
+template <typename SampleType>
+class Chain {
+public:
+    static constexpr int energyStepSamples = 32;
+
+    // Starts on this ENERGY, and at the engine's initial 50% FIELD AMOUNT.
+    // A limiterLookaheadMs above 0 replaces the ceiling with the limiter.
+    void prepare(double sampleRate, int newModeIndex, float energy, float limiterLookaheadMs = 0.0f) {
+        modeIndex = newModeIndex;
+        field.prepare(sampleRate, modeIndex);
+
+        useLimiter = limiterLookaheadMs > 0.0f;
+        limiter.prepare(sampleRate, juce::jmax(limiterLookaheadMs, 0.5f));
+        dryHistory.assign(static_cast<size_t>(getLatencySamples()), StereoSample { SampleType(0), SampleType(0) });
+
+        currentEnergy = targetEnergy = energy;
+        energyStep = 0.0f;
+        energyRampRemaining = 0;
+
+        dryWet.reset(sampleRate, 0.02);
+        dryWet.setCurrentAndTargetValue(SampleType(0.5));
+    }
+
+    int getLatencySamples() const { return useLimiter ? limiter.getLatencySamples() : 0; }
+
+    // One host block; energy and fieldAmount are the parameter values (0-100)
+    void process(SampleType* left, SampleType* right, int numSamples, float energy, float fieldAmount) {
+        const auto& mode = ModePresets::getMode(modeIndex);
+        const auto compensation = juce::Decibels::decibelsToGain(static_cast<SampleType>(mode.compensationTrim));
+
+        if (! juce::exactlyEqual(energy, targetEnergy)) {
+            targetEnergy = energy;
+            energyRampRemaining = juce::jmax(energyStepSamples, numSamples);
+            energyStep = (targetEnergy - currentEnergy) / static_cast<float>(energyRampRemaining);
+        }
+
+        dryWet.setTargetValue(static_cast<SampleType>(fieldAmount / 100.0f));
+
+        for (int i = 0; i < numSamples; ++i) {
+            // A new ENERGY step every 32 samples from the start of the block while ramping
+            if (i % energyStepSamples == 0) {
+                exciter.setExcitation(nextEnergyStep(juce::jmin(energyStepSamples, numSamples - i)), mode.harmonicProfile);
+            }
+
+            const SampleType input = (left[i] + right[i]) * SampleType(0.25);
+            const SampleType shaped = exciter.process(input);
+            const SampleType excited = useLimiter ? limiter.process(shaped) : softCeiling(shaped);
+            const auto wet = field.process(excited);
+            const SampleType wetAmount = dryWet.getNextValue();
+
+            StereoSample dry { left[i], right[i] };
+
+            if (! dryHistory.empty()) {
+                dryHistory.push_back(dry);
+                dry = dryHistory.front();
+                dryHistory.erase(dryHistory.begin());
+            }
+
+            left[i] = dry.left * (SampleType(1) - wetAmount) + wet.left * compensation * wetAmount;
+            right[i] = dry.right * (SampleType(1) - wetAmount) + wet.right * compensation * wetAmount;
+        }
+    }
+
+private:
+    float nextEnergyStep(int numSamples) {
+        const int steps = juce::jmin(numSamples, energyRampRemaining);
+
+        if (steps == 0) {
+            return currentEnergy;
+        }
+
+        const float midpoint = currentEnergy + energyStep * static_cast<float>(steps) * 0.5f;
+        energyRampRemaining -= steps;
+        currentEnergy = energyRampRemaining > 0 ? currentEnergy + energyStep * static_cast<float>(steps) : targetEnergy;
+        return midpoint;
+    }
+
+    using StereoSample = typename Tap<SampleType>::StereoSample;
+
+    int modeIndex = 0;
+    Exciter<SampleType> exciter;
+    LookaheadLimiter<SampleType> limiter;
+    bool useLimiter = false;
+    TapField<SampleType> field;
+    juce::SmoothedValue<SampleType> dryWet;
+    std::vector<StereoSample> dryHistory;   // The last getLatencySamples() inputs
+
+    float currentEnergy = 0.0f;
+    float targetEnergy = 0.0f;
+    float energyStep = 0.0f;
+    int energyRampRemaining = 0;
+};
+
+} // namespace Reference
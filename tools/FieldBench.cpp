@@ -0,0 +1,545 @@
+// FieldBench.cpp
+// FIELD — Projection Engine
+// Benchmarks for each DSP stage and the full processor, swept over sample
+// rates, block sizes, modes and both sample precisions. Results go to stdout
+// as CSV or JSON.
+
+#include <juce_dsp/juce_dsp.h>
+#include "PluginProcessor.h"
+#include "TapProcessor.h"
+
+#include <functional>
+#include <type_traits>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+//==============================================================================
+struct BenchConfig {
+    int mode;
+    double sampleRate;
+    int blockSize;
+};
+
+struct BenchResult {
+    juce::String name;
+    juce::String precision;
+    BenchConfig config;
+    double nsPerSample;
+    double realtimeFactor;
+    int numTaps;                // Tap count of a tap-field benchmark, else 0
+};
+
+// Processes one block (at least blockSize samples) of the benchmark's own input
+using BlockFunction = std::function<void(int numSamples)>;
+
+struct Benchmark {
+    juce::String name;
+    const char* precision;      // "float" or "double"
+    std::function<BlockFunction(const BenchConfig&)> create;
+    int numTaps = 0;            // Set for the tap-count comparisons, to report ns per tap
+};
+
+struct BenchOptions {
+    bool json = false;
+    double seconds = 1.0;       // Audio processed per repeat
+    int repeats = 3;            // Best of
+    juce::String filter;        // Only run benchmarks whose name contains this
+    juce::String precision;     // Only run this precision; empty runs both
+};
+
+constexpr double sampleRates[] = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+constexpr int blockSizes[] = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+
+// Multichannel layouts, benchmarked alongside stereo
+struct LayoutCase {
+    const char* name;
+    juce::AudioChannelSet (*create)();
+};
+
+const LayoutCase surroundLayouts[] = {
+    { "5.1", juce::AudioChannelSet::create5point1 },
+    { "7.1", juce::AudioChannelSet::create7point1 },
+    { "7.1.4", juce::AudioChannelSet::create7point1point4 }
+};
+
+// Stops the optimiser from discarding benchmark output
+volatile float sink = 0.0f;
+
+const ModePresets::ModeConfig& modeFor(const BenchConfig& config)
+{
+    return ModePresets::getMode(config.mode);
+}
+
+// Processes one block of mono input into output
+template <typename SampleType>
+using StageFunction = std::function<void(const SampleType* input, SampleType* output, int numSamples)>;
+
+// A delay line on its own, with the arena holding its buffer
+template <typename SampleType>
+struct StandaloneDelayLine {
+    DspArena arena;
+    DelayLine<SampleType> line;
+
+    explicit StandaloneDelayLine(const BenchConfig& config)
+    {
+        arena.build([&](DspArena& a) {
+            line.prepare(config.sampleRate, ModePresets::maxDelayMs, config.blockSize, a);
+        });
+
+        line.setDelayMs(modeFor(config).taps[0].delayMs);
+    }
+};
+
+// Runs a stage on full-scale white noise, the same sequence for every run
+template <typename SampleType>
+BlockFunction withNoiseInput(const BenchConfig& config, StageFunction<SampleType> stage)
+{
+    auto input = std::make_shared<std::vector<SampleType>>(static_cast<size_t>(config.blockSize));
+    auto output = std::make_shared<std::vector<SampleType>>(static_cast<size_t>(config.blockSize));
+
+    juce::Random random(0x4649454c);
+
+    for (auto& sample : *input)
+        sample = static_cast<SampleType>(random.nextFloat() * 2.0f - 1.0f);
+
+    return [input, output, stage](int numSamples) {
+        stage(input->data(), output->data(), numSamples);
+        sink = sink + static_cast<float>((*output)[0]);
+    };
+}
+
+//==============================================================================
+template <typename SampleType>
+void addBenchmarks(std::vector<Benchmark>& benchmarks, const char* precision)
+{
+    using Stage = StageFunction<SampleType>;
+
+    benchmarks.push_back({ "DelayLine::process", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto delay = std::make_shared<StandaloneDelayLine<SampleType>>(config);
+
+        return withNoiseInput<SampleType>(config, Stage([delay](const SampleType* input, SampleType* output, int numSamples) {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = delay->line.process(input[i]);
+        }));
+    } });
+
+    benchmarks.push_back({ "DelayLine::processBlock", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto delay = std::make_shared<StandaloneDelayLine<SampleType>>(config);
+
+        return withNoiseInput<SampleType>(config, Stage([delay](const SampleType* input, SampleType* output, int numSamples) {
+            delay->line.processBlock(input, output, numSamples);
+        }));
+    } });
+
+    benchmarks.push_back({ "BiquadFilter::process", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto filter = std::make_shared<BiquadFilter<SampleType>>();
+        filter->prepare(config.sampleRate);
+        filter->setType(BiquadFilter<SampleType>::Type::LowPass);
+        filter->setFrequency(modeFor(config).taps[0].lpCutoff);
+
+        return withNoiseInput<SampleType>(config, Stage([filter](const SampleType* input, SampleType* output, int numSamples) {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = filter->process(input[i]);
+        }));
+    } });
+
+    // All six taps, for comparison with TapBank
+    benchmarks.push_back({ "TapProcessor::process", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto taps = std::make_shared<std::array<TapProcessor<SampleType>, TapBank<SampleType>::numTaps>>();
+
+        for (size_t i = 0; i < taps->size(); ++i) {
+            const auto& tap = modeFor(config).taps[i];
+            (*taps)[i].prepare(config.sampleRate, config.blockSize);
+            (*taps)[i].setParameters(tap.delayMs, tap.pan, tap.lpCutoff, tap.gainDb);
+        }
+
+        return withNoiseInput<SampleType>(config, Stage([taps](const SampleType* input, SampleType* output, int numSamples) {
+            for (int i = 0; i < numSamples; ++i) {
+                SampleType left = 0;
+                SampleType right = 0;
+
+                for (auto& tap : *taps) {
+                    const auto out = tap.process(input[i]);
+                    left += out.left;
+                    right += out.right;
+                }
+
+                output[i] = left + right;
+            }
+        }));
+    } });
+
+    benchmarks.push_back({ "TapBank::process", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto bank = std::make_shared<TapBank<SampleType>>();
+        auto right = std::make_shared<std::vector<SampleType>>(static_cast<size_t>(config.blockSize));
+        bank->prepare(config.sampleRate, config.blockSize);
+        bank->setMode(config.mode, false);
+
+        return withNoiseInput<SampleType>(config, Stage([bank, right](const SampleType* input, SampleType* output, int numSamples) {
+            bank->process(input, output, right->data(), numSamples);
+        }));
+    } });
+
+    // Denser fields, to show how the per-tap cost falls as the tap count
+    // grows (reported as ns_per_tap)
+    auto addTapCountBenchmark = [&benchmarks, precision]<size_t NumTaps>(std::integral_constant<size_t, NumTaps>) {
+        benchmarks.push_back({ "TapBank::process " + juce::String(static_cast<int>(NumTaps)) + " taps", precision, [](const BenchConfig& config) -> BlockFunction {
+            auto bank = std::make_shared<TapBank<SampleType, NumTaps>>();
+            auto right = std::make_shared<std::vector<SampleType>>(static_cast<size_t>(config.blockSize));
+            bank->prepare(config.sampleRate, config.blockSize);
+            bank->setMode(config.mode, false);
+
+            return withNoiseInput<SampleType>(config, Stage([bank, right](const SampleType* input, SampleType* output, int numSamples) {
+                bank->process(input, output, right->data(), numSamples);
+            }));
+        }, static_cast<int>(NumTaps) });
+    };
+
+    addTapCountBenchmark(std::integral_constant<size_t, 12> {});
+    addTapCountBenchmark(std::integral_constant<size_t, 24> {});
+    addTapCountBenchmark(std::integral_constant<size_t, 32> {});
+
+    // The same fields as impulse responses through partitioned convolution,
+    // whose cost should not depend on the tap count
+    auto addConvolverBenchmark = [&benchmarks, precision]<size_t NumTaps>(std::integral_constant<size_t, NumTaps>) {
+        benchmarks.push_back({ "FieldConvolver::process " + juce::String(static_cast<int>(NumTaps)) + " taps", precision, [](const BenchConfig& config) -> BlockFunction {
+            auto convolver = std::make_shared<FieldConvolver<SampleType, NumTaps>>();
+            auto right = std::make_shared<std::vector<SampleType>>(static_cast<size_t>(config.blockSize));
+            convolver->prepare(config.sampleRate, config.blockSize);
+            convolver->setMode(config.mode, false);
+            convolver->reset();
+
+            return withNoiseInput<SampleType>(config, Stage([convolver, right](const SampleType* input, SampleType* output, int numSamples) {
+                convolver->process(input, output, right->data(), numSamples);
+            }));
+        }, static_cast<int>(NumTaps) });
+    };
+
+    addConvolverBenchmark(std::integral_constant<size_t, 6> {});
+    addConvolverBenchmark(std::integral_constant<size_t, 32> {});
+
+    // The same field projected into every channel of a surround bed
+    for (const auto& layoutCase : surroundLayouts) {
+        benchmarks.push_back({ juce::String("TapBank::process ") + layoutCase.name, precision, [layoutCase](const BenchConfig& config) -> BlockFunction {
+            const auto layout = layoutCase.create();
+            auto bank = std::make_shared<TapBank<SampleType>>();
+            auto channels = std::make_shared<juce::AudioBuffer<SampleType>>(layout.size(), config.blockSize);
+            bank->prepare(config.sampleRate, config.blockSize, layout);
+            bank->setMode(config.mode, false);
+
+            return withNoiseInput<SampleType>(config, Stage([bank, channels](const SampleType* input, SampleType* output, int numSamples) {
+                bank->process(input, channels->getArrayOfWritePointers(), numSamples);
+                std::copy(channels->getReadPointer(0), channels->getReadPointer(0) + numSamples, output);
+            }));
+        } });
+    }
+
+    benchmarks.push_back({ "HarmonicGenerator::processSample", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto exciter = std::make_shared<HarmonicGenerator<SampleType>>();
+        exciter->setEnergy(50.0f);
+        exciter->setHarmonicProfile(modeFor(config).harmonicProfile);
+
+        return withNoiseInput<SampleType>(config, Stage([exciter](const SampleType* input, SampleType* output, int numSamples) {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = exciter->processSample(input[i]);
+        }));
+    } });
+
+    // Realtime tier: 2x IIR oversampling with the lookup table
+    benchmarks.push_back({ "HarmonicGenerator::processBlock", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto exciter = std::make_shared<HarmonicGenerator<SampleType>>();
+        exciter->prepare(config.blockSize, ExciterOversampling::x2, false);
+        exciter->setUseLookupTable(true);
+        exciter->setEnergy(50.0f);
+        exciter->setHarmonicProfile(modeFor(config).harmonicProfile);
+        exciter->buildCurveTable(50.0f, modeFor(config).harmonicProfile);
+
+        return withNoiseInput<SampleType>(config, Stage([exciter](const SampleType* input, SampleType* output, int numSamples) {
+            std::copy(input, input + numSamples, output);
+            exciter->processBlock(output, numSamples);
+        }));
+    } });
+
+    benchmarks.push_back({ "SoftCeiling::processSample", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto ceiling = std::make_shared<SoftCeiling<SampleType>>();
+
+        return withNoiseInput<SampleType>(config, Stage([ceiling](const SampleType* input, SampleType* output, int numSamples) {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = ceiling->processSample(input[i]);
+        }));
+    } });
+
+    benchmarks.push_back({ "SoftCeiling::processBlock", precision, [](const BenchConfig& config) -> BlockFunction {
+        return withNoiseInput<SampleType>(config, Stage([](const SampleType* input, SampleType* output, int numSamples) {
+            std::copy(input, input + numSamples, output);
+            SoftCeiling<SampleType>::processBlock(output, numSamples);
+        }));
+    } });
+
+    // Exciter and ceiling in one vector pass: 1x with the exact curve
+    benchmarks.push_back({ "HarmonicGenerator::processBlockWithCeiling", precision, [](const BenchConfig& config) -> BlockFunction {
+        auto exciter = std::make_shared<HarmonicGenerator<SampleType>>();
+        exciter->prepare(config.blockSize, ExciterOversampling::x1, false);
+        exciter->setEnergy(50.0f);
+        exciter->setHarmonicProfile(modeFor(config).harmonicProfile);
+
+        return withNoiseInput<SampleType>(config, Stage([exciter](const SampleType* input, SampleType* output, int numSamples) {
+            std::copy(input, input + numSamples, output);
+            exciter->processBlockWithCeiling(output, numSamples);
+        }));
+    } });
+
+    // Full-scale noise keeps it limiting, so every block takes the per-sample
+    // path; the longest lookahead shows the window length costs nothing
+    benchmarks.push_back({ "LookaheadLimiter::process", precision, [](const BenchConfig& config) -> BlockFunction {
+        struct StandaloneLimiter {
+            DspArena arena;
+            LookaheadLimiter<SampleType> limiter;
+        };
+
+        auto state = std::make_shared<StandaloneLimiter>();
+        state->arena.build([&](DspArena& a) {
+            state->limiter.prepare(config.sampleRate, LookaheadLimiter<SampleType>::maxLookaheadMs, config.blockSize, a);
+        });
+
+        return withNoiseInput<SampleType>(config, Stage([state](const SampleType* input, SampleType* output, int numSamples) {
+            std::copy(input, input + numSamples, output);
+            state->limiter.process(output, numSamples);
+        }));
+    } });
+
+    // Whole plugin at the realtime tier, including the input copy, for stereo
+    // (with either field renderer) and each surround layout
+    auto addProcessorBenchmark = [&benchmarks, precision](const juce::String& name, juce::AudioChannelSet (*createLayout)(),
+                                                          FieldRenderer renderer) {
+        benchmarks.push_back({ name, precision, [createLayout, renderer](const BenchConfig& config) -> BlockFunction {
+            const auto layout = createLayout();
+            auto processor = std::make_shared<FieldAudioProcessor>();
+            auto buffer = std::make_shared<juce::AudioBuffer<SampleType>>(layout.size(), config.blockSize);
+
+            auto setParameter = [&processor](const juce::String& parameterID, float value) {
+                if (auto* param = processor->apvts.getParameter(parameterID))
+                    param->setValueNotifyingHost(param->convertTo0to1(value));
+            };
+
+            setParameter("mode", static_cast<float>(config.mode));
+            setParameter("energy", 50.0f);
+            setParameter("field_amount", 50.0f);
+
+            processor->getBus(true, 0)->setCurrentLayout(layout);
+            processor->getBus(false, 0)->setCurrentLayout(layout);
+            processor->setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                                 : juce::AudioProcessor::singlePrecision);
+            processor->setFieldRenderer(renderer);
+            processor->setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+            processor->prepareToPlay(config.sampleRate, config.blockSize);
+
+            return withNoiseInput<SampleType>(config, Stage([processor, buffer](const SampleType* input, SampleType* output, int numSamples) {
+                juce::MidiBuffer midi;
+                buffer->setSize(buffer->getNumChannels(), numSamples, false, false, true);
+
+                for (int channel = 0; channel < buffer->getNumChannels(); ++channel)
+                    buffer->copyFrom(channel, 0, input, numSamples);
+
+                processor->processBlock(*buffer, midi);
+                std::copy(buffer->getReadPointer(0), buffer->getReadPointer(0) + numSamples, output);
+            }));
+        } });
+    };
+
+    addProcessorBenchmark("FieldAudioProcessor::processBlock", juce::AudioChannelSet::stereo, FieldRenderer::taps);
+    addProcessorBenchmark("FieldAudioProcessor::processBlock convolution", juce::AudioChannelSet::stereo, FieldRenderer::convolution);
+
+    for (const auto& layoutCase : surroundLayouts)
+        addProcessorBenchmark(juce::String("FieldAudioProcessor::processBlock ") + layoutCase.name, layoutCase.create, FieldRenderer::taps);
+}
+
+std::vector<Benchmark> createBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+    addBenchmarks<float>(benchmarks, "float");
+    addBenchmarks<double>(benchmarks, "double");
+    return benchmarks;
+}
+
+//==============================================================================
+BenchResult runBenchmark(const Benchmark& benchmark, const BenchConfig& config, const BenchOptions& options)
+{
+    auto process = benchmark.create(config);
+
+    const auto numBlocks = juce::jmax(1, static_cast<int>(std::ceil(options.seconds * config.sampleRate / config.blockSize)));
+
+    // Warm caches, smoothers and the exciter table
+    for (int block = 0; block < numBlocks / 10 + 1; ++block)
+        process(config.blockSize);
+
+    double bestSeconds = std::numeric_limits<double>::max();
+
+    for (int repeat = 0; repeat < options.repeats; ++repeat) {
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+            process(config.blockSize);
+
+        const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        bestSeconds = juce::jmin(bestSeconds, elapsed);
+    }
+
+    const double numSamples = static_cast<double>(numBlocks) * config.blockSize;
+    const double audioSeconds = numSamples / config.sampleRate;
+
+    return { benchmark.name, benchmark.precision, config, bestSeconds * 1.0e9 / numSamples, audioSeconds / bestSeconds, benchmark.numTaps };
+}
+
+//==============================================================================
+// Per-tap cost of a tap-field benchmark, which stays flat (TapBank) or falls
+// (FieldConvolver) as the field grows
+double nsPerTap(const BenchResult& result)
+{
+    return result.nsPerSample / result.numTaps;
+}
+
+void printCsvHeader()
+{
+    std::cout << "benchmark,precision,mode,sample_rate,block_size,ns_per_sample,realtime_factor,ns_per_tap\n";
+}
+
+void printCsvRow(const BenchResult& result)
+{
+    std::cout << result.name << ','
+              << result.precision << ','
+              << modeFor(result.config).name << ','
+              << result.config.sampleRate << ','
+              << result.config.blockSize << ','
+              << result.nsPerSample << ','
+              << result.realtimeFactor << ',';
+
+    // Left empty for benchmarks that are not a tap-count comparison
+    if (result.numTaps > 0)
+        std::cout << nsPerTap(result);
+
+    std::cout << '\n';
+}
+
+void printJson(const std::vector<BenchResult>& results, const BenchOptions& options)
+{
+    std::cout << "{\n"
+              << "  \"juce_version\": \"" << juce::SystemStats::getJUCEVersion() << "\",\n"
+              << "  \"cpu\": \"" << juce::SystemStats::getCpuModel() << "\",\n"
+              << "  \"seconds_per_repeat\": " << options.seconds << ",\n"
+              << "  \"repeats\": " << options.repeats << ",\n"
+              << "  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+
+        std::cout << "    { \"benchmark\": \"" << result.name
+                  << "\", \"precision\": \"" << result.precision
+                  << "\", \"mode\": \"" << modeFor(result.config).name
+                  << "\", \"sample_rate\": " << result.config.sampleRate
+                  << ", \"block_size\": " << result.config.blockSize
+                  << ", \"ns_per_sample\": " << result.nsPerSample
+                  << ", \"realtime_factor\": " << result.realtimeFactor;
+
+        if (result.numTaps > 0)
+            std::cout << ", \"ns_per_tap\": " << nsPerTap(result);
+
+        std::cout << (i + 1 < results.size() ? " },\n" : " }\n");
+    }
+
+    std::cout << "  ]\n}\n";
+}
+
+void printUsage()
+{
+    std::cout << "Usage: field_bench [options]\n"
+                 "\n"
+                 "Options:\n"
+                 "  --format <csv|json>    Output format (default: csv)\n"
+                 "  --seconds <s>          Audio processed per repeat (default: 1)\n"
+                 "  --repeats <n>          Repeats per configuration, best is reported (default: 3)\n"
+                 "  --filter <text>        Only run benchmarks whose name contains text\n"
+                 "  --precision <p>        float or double (default: both)\n";
+}
+
+bool parseArguments(int argc, char* argv[], BenchOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        auto name = arg.upToFirstOccurrenceOf("=", false, false);
+        juce::String value;
+
+        // Accept both "--name value" and "--name=value"
+        if (arg.containsChar('=')) {
+            value = arg.fromFirstOccurrenceOf("=", false, false);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            return false;
+        }
+
+        if (name == "--format" && (value == "csv" || value == "json"))
+            options.json = value == "json";
+        else if (name == "--seconds")
+            options.seconds = juce::jmax(0.01, value.getDoubleValue());
+        else if (name == "--repeats")
+            options.repeats = juce::jmax(1, value.getIntValue());
+        else if (name == "--filter")
+            options.filter = value;
+        else if (name == "--precision" && (value == "float" || value == "double"))
+            options.precision = value;
+        else
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    if (! parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // The processor relies on the message manager (parameter state, timers)
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::vector<BenchResult> results;
+
+    if (! options.json)
+        printCsvHeader();
+
+    for (const auto& benchmark : createBenchmarks()) {
+        if (options.filter.isNotEmpty() && ! benchmark.name.contains(options.filter))
+            continue;
+
+        if (options.precision.isNotEmpty() && options.precision != benchmark.precision)
+            continue;
+
+        for (int mode = 0; mode < static_cast<int>(ModePresets::allModes.size()); ++mode) {
+            for (const auto sampleRate : sampleRates) {
+                for (const auto blockSize : blockSizes) {
+                    const auto result = runBenchmark(benchmark, { mode, sampleRate, blockSize }, options);
+
+                    if (options.json)
+                        results.push_back(result);
+                    else
+                        printCsvRow(result);
+                }
+            }
+        }
+    }
+
+    if (options.json)
+        printJson(results, options);
+
+    return 0;
+}
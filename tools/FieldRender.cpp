@@ -0,0 +1,558 @@
+// FieldRender.cpp
+// FIELD — Projection Engine
+// Headless offline renderer: streams WAV/AIFF files through FieldAudioProcessor,
+// one file at a time or as chunks spread over every core
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "PluginProcessor.h"
+#include "WorkStealingPool.h"
+
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace {
+
+struct RenderJob {
+    juce::File input;
+    juce::File output;
+};
+
+struct RenderOptions {
+    std::vector<RenderJob> files;
+    int mode = 0;               // 0 = Studio, 1 = Sound System
+    float energy = 0.0f;        // 0-100
+    float fieldAmount = 50.0f;  // 0-100
+    int blockSize = 512;
+    int bitDepth = 24;
+    bool includeTail = false;
+    FieldRenderer renderer = FieldRenderer::taps;
+    float lookaheadMs = 0.0f;   // Lookahead limiter instead of the soft ceiling; 0 = off
+    int jobs = 1;               // Worker threads; 1 streams each file serially
+    double chunkSeconds = 10.0; // Audio per parallel task
+};
+
+void printUsage()
+{
+    std::cout << "Usage: field_render [options] <input.wav|aif> <output.wav|aif>\n"
+                 "       field_render [options] --output-dir <dir> <input.wav|aif>...\n"
+                 "\n"
+                 "Options:\n"
+                 "  --mode <studio|sound-system>  Mode preset (default: studio)\n"
+                 "  --energy <0-100>              ENERGY (default: 0)\n"
+                 "  --field <0-100>               FIELD AMOUNT (default: 50)\n"
+                 "  --block-size <n>              Samples per processBlock call (default: 512)\n"
+                 "  --bits <16|24|32>             Output bit depth (default: 24)\n"
+                 "  --renderer <taps|convolution> Tap field renderer (default: taps)\n"
+                 "  --limiter <0.5-5>             True-peak lookahead limiter with this lookahead in ms,\n"
+                 "                                instead of the soft ceiling (default: off)\n"
+                 "  --tail                        Append the processor's tail to the output\n"
+                 "  --jobs <n>                    Render chunks of every file on n threads, 0 = one per core (default: 1)\n"
+                 "  --chunk <seconds>             Audio per parallel chunk (default: 10)\n"
+                 "  --output-dir <dir>            Render each input into dir under its own file name\n";
+}
+
+bool parseArguments(int argc, char* argv[], RenderOptions& options)
+{
+    juce::StringArray positional;
+    juce::File outputDirectory;
+
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+
+        if (! arg.startsWith("--")) {
+            positional.add(arg);
+            continue;
+        }
+
+        // Accept both "--name value" and "--name=value"
+        auto name = arg.upToFirstOccurrenceOf("=", false, false);
+        juce::String value;
+
+        if (name == "--tail") {
+            options.includeTail = true;
+            continue;
+        }
+
+        if (arg.containsChar('=')) {
+            value = arg.fromFirstOccurrenceOf("=", false, false);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            std::cerr << "Missing value for " << name << "\n";
+            return false;
+        }
+
+        if (name == "--mode") {
+            if (value == "studio" || value == "0")
+                options.mode = 0;
+            else if (value == "sound-system" || value == "1")
+                options.mode = 1;
+            else {
+                std::cerr << "Unknown mode: " << value << "\n";
+                return false;
+            }
+        } else if (name == "--energy") {
+            options.energy = juce::jlimit(0.0f, 100.0f, value.getFloatValue());
+        } else if (name == "--field") {
+            options.fieldAmount = juce::jlimit(0.0f, 100.0f, value.getFloatValue());
+        } else if (name == "--block-size") {
+            options.blockSize = juce::jlimit(1, 65536, value.getIntValue());
+        } else if (name == "--bits") {
+            options.bitDepth = value.getIntValue();
+        } else if (name == "--jobs") {
+            const int jobs = value.getIntValue();
+            options.jobs = jobs > 0 ? jobs : juce::SystemStats::getNumCpus();
+        } else if (name == "--chunk") {
+            options.chunkSeconds = juce::jmax(0.1, value.getDoubleValue());
+        } else if (name == "--limiter") {
+            options.lookaheadMs = juce::jlimit(0.5f, 5.0f, value.getFloatValue());
+        } else if (name == "--output-dir") {
+            outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        } else if (name == "--renderer") {
+            if (value == "taps")
+                options.renderer = FieldRenderer::taps;
+            else if (value == "convolution")
+                options.renderer = FieldRenderer::convolution;
+            else {
+                std::cerr << "Unknown renderer: " << value << "\n";
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown option: " << name << "\n";
+            return false;
+        }
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    if (outputDirectory != juce::File()) {
+        if (positional.isEmpty())
+            return false;
+
+        if (! outputDirectory.createDirectory()) {
+            std::cerr << "Cannot create " << outputDirectory.getFullPathName() << "\n";
+            return false;
+        }
+
+        for (const auto& input : positional) {
+            const auto file = cwd.getChildFile(input);
+            options.files.push_back({ file, outputDirectory.getChildFile(file.getFileName()) });
+        }
+
+        return true;
+    }
+
+    if (positional.size() != 2)
+        return false;
+
+    options.files.push_back({ cwd.getChildFile(positional[0]), cwd.getChildFile(positional[1]) });
+    return true;
+}
+
+void setParameter(FieldAudioProcessor& processor, const juce::String& parameterID, float value)
+{
+    if (auto* param = processor.apvts.getParameter(parameterID))
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+// Stereo, or a surround bed with its channels in the plugin's order
+juce::AudioChannelSet layoutForChannels(int numChannels)
+{
+    switch (numChannels) {
+        case 1:
+        case 2:  return juce::AudioChannelSet::stereo();
+        case 6:  return juce::AudioChannelSet::create5point1();
+        case 8:  return juce::AudioChannelSet::create7point1();
+        case 12: return juce::AudioChannelSet::create7point1point4();
+        default: return juce::AudioChannelSet::disabled();
+    }
+}
+
+// Parameters shared by every file; called once per processor instance
+void configureProcessor(FieldAudioProcessor& processor, const RenderOptions& options)
+{
+    setParameter(processor, "mode", static_cast<float>(options.mode));
+    setParameter(processor, "energy", options.energy);
+    setParameter(processor, "field_amount", options.fieldAmount);
+
+    processor.setNonRealtime(true);
+    processor.setFieldRenderer(options.renderer);
+    processor.setLookaheadLimiter(options.lookaheadMs > 0.0f, options.lookaheadMs);
+}
+
+// Offline quality tier, fresh DSP state
+void prepareProcessor(FieldAudioProcessor& processor, const juce::AudioChannelSet& layout, double sampleRate, int blockSize)
+{
+    processor.getBus(true, 0)->setCurrentLayout(layout);
+    processor.getBus(false, 0)->setCurrentLayout(layout);
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+juce::int64 getTailSamples(const RenderOptions& options, const FieldAudioProcessor& processor, double sampleRate)
+{
+    return options.includeTail ? static_cast<juce::int64>(std::ceil(processor.getTailLengthSeconds() * sampleRate)) : 0;
+}
+
+// Reads one block at position into buffer; past the end of the input it
+// reads silence, which flushes the latency and tail
+void readBlock(juce::AudioFormatReader& reader, juce::AudioBuffer<float>& buffer, juce::int64 position)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    buffer.clear();
+    reader.read(&buffer, 0, numSamples, position, true, true);
+
+    if (reader.numChannels == 1)
+        buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+}
+
+// Everything about an input decided before rendering starts
+struct FileSetup {
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    juce::AudioChannelSet layout;
+    double sampleRate = 44100.0;
+};
+
+bool openFiles(juce::AudioFormatManager& formatManager, const RenderJob& job, int bitDepth, FileSetup& setup)
+{
+    setup.reader.reset(formatManager.createReaderFor(job.input));
+
+    if (setup.reader == nullptr) {
+        std::cerr << "Cannot read " << job.input.getFullPathName() << "\n";
+        return false;
+    }
+
+    setup.layout = layoutForChannels(static_cast<int>(setup.reader->numChannels));
+    setup.sampleRate = setup.reader->sampleRate;
+
+    if (setup.layout.isDisabled()) {
+        std::cerr << job.input.getFileName() << ": only mono, stereo, 5.1, 7.1 and 7.1.4 files are supported\n";
+        return false;
+    }
+
+    auto* format = formatManager.findFormatForFileExtension(job.output.getFileExtension());
+
+    if (format == nullptr) {
+        std::cerr << "Unsupported output format: " << job.output.getFileName() << "\n";
+        return false;
+    }
+
+    // Writer (FileOutputStream appends, so start from an empty file)
+    job.output.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(job.output.createOutputStream());
+
+    if (stream == nullptr || ! stream->openedOk()) {
+        std::cerr << "Cannot write " << job.output.getFullPathName() << "\n";
+        return false;
+    }
+
+    setup.writer.reset(format->createWriterFor(stream.get(), setup.sampleRate, static_cast<unsigned int>(setup.layout.size()),
+                                               bitDepth, {}, 0));
+
+    if (setup.writer == nullptr) {
+        std::cerr << "Unsupported bit depth for " << format->getFormatName() << ": " << bitDepth << "\n";
+        return false;
+    }
+
+    stream.release();   // Owned by the writer now
+    return true;
+}
+
+void printTruePeak(float truePeak)
+{
+    std::cout << "True peak (L/R): " << juce::Decibels::gainToDecibels(truePeak) << " dBTP\n";
+}
+
+//==============================================================================
+// One file, streamed through a single processor in blockSize chunks
+int renderSerial(const RenderOptions& options, const RenderJob& job)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    FileSetup setup;
+
+    if (! openFiles(formatManager, job, options.bitDepth, setup))
+        return 1;
+
+    const int numChannels = setup.layout.size();
+    const int blockSize = options.blockSize;
+
+    // Processor setup: no editor, offline quality tier
+    FieldAudioProcessor processor;
+    configureProcessor(processor, options);
+    prepareProcessor(processor, setup.layout, setup.sampleRate, blockSize);
+
+    const int latency = processor.getLatencySamples();
+    const juce::int64 outputLength = setup.reader->lengthInSamples + getTailSamples(options, processor, setup.sampleRate);
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+    juce::int64 readPosition = 0;
+    juce::int64 written = 0;
+    int latencyToSkip = latency;
+    juce::int64 processTicks = 0;
+    float truePeak = 0.0f;
+
+    while (written < outputLength) {
+        readBlock(*setup.reader, buffer, readPosition);
+        readPosition += blockSize;
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midi);
+        processTicks += juce::Time::getHighResolutionTicks() - start;
+
+        processor.getTelemetry().drain([&truePeak](const TelemetryFrame& frame) {
+            truePeak = juce::jmax(truePeak, frame.truePeakLeft, frame.truePeakRight);
+        });
+
+        // Drop the first `latency` samples so the output lines up with the input
+        const int skip = juce::jmin(latencyToSkip, blockSize);
+        latencyToSkip -= skip;
+
+        const auto numToWrite = static_cast<int>(juce::jmin(static_cast<juce::int64>(blockSize - skip), outputLength - written));
+
+        if (numToWrite > 0) {
+            setup.writer->writeFromAudioSampleBuffer(buffer, skip, numToWrite);
+            written += numToWrite;
+        }
+    }
+
+    processor.releaseResources();
+
+    const double audioSeconds = static_cast<double>(outputLength) / setup.sampleRate;
+    const double processSeconds = juce::Time::highResolutionTicksToSeconds(processTicks);
+
+    std::cout << job.output.getFileName() << ": " << audioSeconds << " s rendered in "
+              << processSeconds << " s (" << (processSeconds > 0.0 ? audioSeconds / processSeconds : 0.0)
+              << "x realtime, block size " << blockSize << ", latency " << latency << " samples)\n";
+    printTruePeak(truePeak);
+
+    return 0;
+}
+
+//==============================================================================
+// A file split into chunks. Chunks finish in any order and are written in
+// order by whichever worker completes the next one due.
+struct ChunkedFile {
+    RenderJob job;
+    juce::AudioChannelSet layout;
+    double sampleRate = 44100.0;
+    juce::int64 outputLength = 0;
+    juce::int64 chunkLength = 0;
+    juce::int64 preRoll = 0;
+    int latency = 0;
+    int numChunks = 0;
+
+    std::mutex mutex;           // Guards everything below
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    std::map<int, juce::AudioBuffer<float>> finishedChunks;
+    int nextChunkToWrite = 0;
+    float truePeak = 0.0f;
+    bool failed = false;
+};
+
+// Renders output samples [chunk * chunkLength, +chunkLength) of file.
+//
+// The processor's state reaches back at most its tail: the longest tap
+// delay plus filter ring-out to -120 dB, plus the oversampling latency, and
+// the dry/wet and ENERGY ramps settle well within that. Starting that far
+// (plus one more latency for the oversampling filters' history) before the
+// chunk, on the same block grid as a serial render, leaves every block of
+// the chunk computed from the same state as the serial render would have.
+void renderChunk(FieldAudioProcessor& processor, juce::AudioFormatManager& formatManager,
+                 ChunkedFile& file, int chunk, int blockSize)
+{
+    const juce::int64 chunkStart = chunk * file.chunkLength;
+    const auto length = static_cast<int>(juce::jmin(file.chunkLength, file.outputLength - chunkStart));
+
+    // Output sample t comes out of the processor as processed sample t + latency
+    const juce::int64 firstProcessed = chunkStart + file.latency;
+    const juce::int64 endProcessed = firstProcessed + length;
+    juce::int64 position = juce::jmax(juce::int64 { 0 }, firstProcessed - file.preRoll) / blockSize * blockSize;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file.job.input));
+
+    if (reader == nullptr) {
+        std::lock_guard<std::mutex> lock(file.mutex);
+        file.failed = true;
+        return;
+    }
+
+    prepareProcessor(processor, file.layout, file.sampleRate, blockSize);
+
+    juce::AudioBuffer<float> output(file.layout.size(), length);
+    juce::AudioBuffer<float> buffer(file.layout.size(), blockSize);
+    juce::MidiBuffer midi;
+    float truePeak = 0.0f;
+
+    while (position < endProcessed) {
+        readBlock(*reader, buffer, position);
+        processor.processBlock(buffer, midi);
+
+        // Pre-roll blocks only warm the state up
+        const auto from = juce::jmax(position, firstProcessed);
+        const auto to = juce::jmin(position + blockSize, endProcessed);
+
+        processor.getTelemetry().drain([&truePeak, from, to](const TelemetryFrame& frame) {
+            if (from < to)
+                truePeak = juce::jmax(truePeak, frame.truePeakLeft, frame.truePeakRight);
+        });
+
+        if (from < to) {
+            for (int channel = 0; channel < file.layout.size(); ++channel)
+                output.copyFrom(channel, static_cast<int>(from - firstProcessed), buffer, channel,
+                                static_cast<int>(from - position), static_cast<int>(to - from));
+        }
+
+        position += blockSize;
+    }
+
+    processor.releaseResources();
+
+    std::lock_guard<std::mutex> lock(file.mutex);
+    file.truePeak = juce::jmax(file.truePeak, truePeak);
+    file.finishedChunks.emplace(chunk, std::move(output));
+
+    for (auto next = file.finishedChunks.find(file.nextChunkToWrite); next != file.finishedChunks.end();
+         next = file.finishedChunks.find(file.nextChunkToWrite)) {
+        if (! file.writer->writeFromAudioSampleBuffer(next->second, 0, next->second.getNumSamples()))
+            file.failed = true;
+
+        file.finishedChunks.erase(next);
+        ++file.nextChunkToWrite;
+    }
+}
+
+// Every file, split into chunks rendered by independent processors, one per
+// worker. Chunks of all files share one work-stealing pool, so short files
+// and the last chunks of long ones keep every core busy.
+int renderParallel(const RenderOptions& options)
+{
+    const int blockSize = options.blockSize;
+    WorkStealingPool pool(options.jobs);
+
+    // Per-worker processors and readers; each task uses only its worker's
+    std::vector<std::unique_ptr<FieldAudioProcessor>> processors;
+    std::vector<std::unique_ptr<juce::AudioFormatManager>> formatManagers;
+
+    for (int worker = 0; worker < pool.getNumWorkers(); ++worker) {
+        processors.push_back(std::make_unique<FieldAudioProcessor>());
+        configureProcessor(*processors.back(), options);
+
+        formatManagers.push_back(std::make_unique<juce::AudioFormatManager>());
+        formatManagers.back()->registerBasicFormats();
+    }
+
+    // Open every file and size its chunks up front
+    std::vector<std::unique_ptr<ChunkedFile>> files;
+    juce::int64 totalSamples = 0;
+    double totalSeconds = 0.0;
+    int totalChunks = 0;
+
+    for (const auto& job : options.files) {
+        FileSetup setup;
+
+        if (! openFiles(*formatManagers[0], job, options.bitDepth, setup))
+            return 1;
+
+        // Latency and tail of this layout and rate
+        auto& probe = *processors[0];
+        prepareProcessor(probe, setup.layout, setup.sampleRate, blockSize);
+
+        auto file = std::make_unique<ChunkedFile>();
+        file->job = job;
+        file->layout = setup.layout;
+        file->sampleRate = setup.sampleRate;
+        file->writer = std::move(setup.writer);
+        file->latency = probe.getLatencySamples();
+        file->outputLength = setup.reader->lengthInSamples + getTailSamples(options, probe, setup.sampleRate);
+
+        // Long enough for the tail, the latency and any limiter gain reduction
+        // to play out, so each chunk starts in the serial render's state
+        const double preRollSeconds = probe.getTailLengthSeconds() + probe.getLimiterSettlingSeconds();
+        file->preRoll = static_cast<juce::int64>(std::ceil(preRollSeconds * setup.sampleRate)) + file->latency;
+
+        file->chunkLength = juce::jmax(static_cast<juce::int64>(blockSize),
+                                       static_cast<juce::int64>(options.chunkSeconds * setup.sampleRate));
+        file->numChunks = static_cast<int>((file->outputLength + file->chunkLength - 1) / file->chunkLength);
+
+        probe.releaseResources();
+
+        totalSamples += file->outputLength;
+        totalSeconds += static_cast<double>(file->outputLength) / setup.sampleRate;
+        totalChunks += file->numChunks;
+        files.push_back(std::move(file));
+    }
+
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    for (auto& file : files) {
+        for (int chunk = 0; chunk < file->numChunks; ++chunk) {
+            pool.submit([&processors, &formatManagers, &file = *file, chunk, blockSize](int worker) {
+                renderChunk(*processors[static_cast<size_t>(worker)], *formatManagers[static_cast<size_t>(worker)],
+                            file, chunk, blockSize);
+            });
+        }
+    }
+
+    pool.wait();
+
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    int result = 0;
+
+    for (auto& file : files) {
+        file->writer.reset();   // Finalises the header
+
+        if (file->failed || file->nextChunkToWrite != file->numChunks) {
+            std::cerr << "Failed to render " << file->job.output.getFullPathName() << "\n";
+            result = 1;
+            continue;
+        }
+
+        std::cout << file->job.output.getFileName() << ": " << static_cast<double>(file->outputLength) / file->sampleRate
+                  << " s in " << file->numChunks << " chunks (latency " << file->latency << ", pre-roll "
+                  << file->preRoll << " samples)\n";
+        printTruePeak(file->truePeak);
+    }
+
+    std::cout << totalSeconds << " s of audio (" << totalSamples << " samples, " << totalChunks << " chunks) rendered in "
+              << wallSeconds << " s on " << pool.getNumWorkers() << " threads ("
+              << (wallSeconds > 0.0 ? totalSeconds / wallSeconds : 0.0) << "x realtime, block size " << blockSize << ")\n";
+
+    return result;
+}
+
+int render(const RenderOptions& options)
+{
+    if (options.jobs > 1)
+        return renderParallel(options);
+
+    for (const auto& job : options.files) {
+        if (const int result = renderSerial(options, job); result != 0)
+            return result;
+    }
+
+    return 0;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    RenderOptions options;
+
+    if (! parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // The processor relies on the message manager (parameter state, timers)
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    return render(options);
+}
@@ -0,0 +1,160 @@
+// WorkStealingPool.h
+// FIELD — Projection Engine
+// Fixed set of worker threads, each with its own task deque, stealing from the others when idle
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs coarse tasks (whole render chunks) on numWorkers threads.
+ *
+ * Tasks are dealt round-robin into per-worker deques, so each worker starts
+ * on its own share in submission order. A worker that runs dry takes the
+ * oldest task from the next busy worker rather than sitting idle, which
+ * evens out files and chunks of different lengths without a single shared
+ * queue every worker contends on.
+ *
+ * Each task is told the index of the worker running it, so per-worker state
+ * (a processor instance, scratch buffers) can be reused without locking.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void(int worker)>;
+
+    explicit WorkStealingPool(int numWorkers) {
+        queues.reserve(static_cast<size_t>(juce::jmax(1, numWorkers)));
+
+        for (int i = 0; i < juce::jmax(1, numWorkers); ++i) {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        for (int i = 0; i < getNumWorkers(); ++i) {
+            threads.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    // Finishes everything already submitted first
+    ~WorkStealingPool() {
+        wait();
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+
+        workAvailable.notify_all();
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int getNumWorkers() const { return static_cast<int>(queues.size()); }
+
+    void submit(Task task) {
+        auto& queue = *queues[static_cast<size_t>(nextQueue)];
+        nextQueue = (nextQueue + 1) % getNumWorkers();
+
+        // Pending before it is visible, so it cannot finish uncounted
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            ++numPending;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            ++numSubmitted;
+        }
+
+        workAvailable.notify_all();
+    }
+
+    // Blocks until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        allDone.wait(lock, [this] { return numPending == 0; });
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(int worker) {
+        for (;;) {
+            int submittedBefore = 0;
+
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                submittedBefore = numSubmitted;
+            }
+
+            Task task;
+
+            if (takeTask(worker, task)) {
+                task(worker);
+
+                std::lock_guard<std::mutex> lock(stateMutex);
+
+                if (--numPending == 0) {
+                    allDone.notify_all();
+                }
+
+                continue;
+            }
+
+            // Nothing anywhere: sleep until something is submitted after the
+            // scan started, or the pool shuts down
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this, submittedBefore] { return stopping || numSubmitted != submittedBefore; });
+
+            if (stopping) {
+                return;
+            }
+        }
+    }
+
+    // Own queue first, then the others in turn, oldest task first
+    bool takeTask(int worker, Task& task) {
+        for (int i = 0; i < getNumWorkers(); ++i) {
+            auto& queue = *queues[static_cast<size_t>((worker + i) % getNumWorkers())];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (! queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    int nextQueue = 0;                  // submit() is called from one thread
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    int numPending = 0;                 // Queued or running
+    int numSubmitted = 0;
+    bool stopping = false;
+
+    JUCE_DECLARE_NON_COPYABLE(WorkStealingPool)
+};